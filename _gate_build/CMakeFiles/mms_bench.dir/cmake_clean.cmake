@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mms_bench.dir/cpp/benchmarks/bench_primitives.cpp.o"
+  "CMakeFiles/mms_bench.dir/cpp/benchmarks/bench_primitives.cpp.o.d"
+  "mms_bench"
+  "mms_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mms_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cpp/src/agents.cpp" "CMakeFiles/mms_core.dir/cpp/src/agents.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/agents.cpp.o.d"
+  "/root/repo/cpp/src/differential.cpp" "CMakeFiles/mms_core.dir/cpp/src/differential.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/differential.cpp.o.d"
+  "/root/repo/cpp/src/event_journal.cpp" "CMakeFiles/mms_core.dir/cpp/src/event_journal.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/event_journal.cpp.o.d"
+  "/root/repo/cpp/src/multi_instrument.cpp" "CMakeFiles/mms_core.dir/cpp/src/multi_instrument.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/multi_instrument.cpp.o.d"
+  "/root/repo/cpp/src/order_book.cpp" "CMakeFiles/mms_core.dir/cpp/src/order_book.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/order_book.cpp.o.d"
+  "/root/repo/cpp/src/simd_kernels.cpp" "CMakeFiles/mms_core.dir/cpp/src/simd_kernels.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/simd_kernels.cpp.o.d"
+  "/root/repo/cpp/src/simulator.cpp" "CMakeFiles/mms_core.dir/cpp/src/simulator.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/simulator.cpp.o.d"
+  "/root/repo/cpp/src/sweep.cpp" "CMakeFiles/mms_core.dir/cpp/src/sweep.cpp.o" "gcc" "CMakeFiles/mms_core.dir/cpp/src/sweep.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
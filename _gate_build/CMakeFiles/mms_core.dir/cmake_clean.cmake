@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mms_core.dir/cpp/src/agents.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/agents.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/differential.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/differential.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/event_journal.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/event_journal.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/multi_instrument.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/multi_instrument.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/order_book.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/order_book.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/simd_kernels.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/simd_kernels.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/simulator.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/simulator.cpp.o.d"
+  "CMakeFiles/mms_core.dir/cpp/src/sweep.cpp.o"
+  "CMakeFiles/mms_core.dir/cpp/src/sweep.cpp.o.d"
+  "libmms_core.a"
+  "libmms_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mms_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
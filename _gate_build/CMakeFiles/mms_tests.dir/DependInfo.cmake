@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cpp/tests/test_agents.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_agents.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_agents.cpp.o.d"
+  "/root/repo/cpp/tests/test_arena.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_arena.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_arena.cpp.o.d"
+  "/root/repo/cpp/tests/test_differential.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_differential.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_differential.cpp.o.d"
+  "/root/repo/cpp/tests/test_event_journal.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_event_journal.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_event_journal.cpp.o.d"
+  "/root/repo/cpp/tests/test_instrumentation.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_instrumentation.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_instrumentation.cpp.o.d"
+  "/root/repo/cpp/tests/test_matching_engine.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_matching_engine.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_matching_engine.cpp.o.d"
+  "/root/repo/cpp/tests/test_multi_instrument.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_multi_instrument.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_multi_instrument.cpp.o.d"
+  "/root/repo/cpp/tests/test_network.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_network.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_network.cpp.o.d"
+  "/root/repo/cpp/tests/test_order_book.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_order_book.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_order_book.cpp.o.d"
+  "/root/repo/cpp/tests/test_rng.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_rng.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_rng.cpp.o.d"
+  "/root/repo/cpp/tests/test_simd_kernels.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_simd_kernels.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_simd_kernels.cpp.o.d"
+  "/root/repo/cpp/tests/test_simulator.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_simulator.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_simulator.cpp.o.d"
+  "/root/repo/cpp/tests/test_spsc_ring.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_spsc_ring.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_spsc_ring.cpp.o.d"
+  "/root/repo/cpp/tests/test_sweep.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_sweep.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_sweep.cpp.o.d"
+  "/root/repo/cpp/tests/test_types.cpp" "CMakeFiles/mms_tests.dir/cpp/tests/test_types.cpp.o" "gcc" "CMakeFiles/mms_tests.dir/cpp/tests/test_types.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/CMakeFiles/mms_core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
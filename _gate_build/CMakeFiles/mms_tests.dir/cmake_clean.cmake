@@ -0,0 +1,39 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_agents.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_agents.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_arena.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_arena.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_differential.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_differential.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_event_journal.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_event_journal.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_instrumentation.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_instrumentation.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_matching_engine.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_matching_engine.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_multi_instrument.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_multi_instrument.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_network.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_network.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_order_book.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_order_book.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_rng.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_rng.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_simd_kernels.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_simd_kernels.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_simulator.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_simulator.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_spsc_ring.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_spsc_ring.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_sweep.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_sweep.cpp.o.d"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_types.cpp.o"
+  "CMakeFiles/mms_tests.dir/cpp/tests/test_types.cpp.o.d"
+  "mms_tests"
+  "mms_tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mms_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simple_sim.dir/cpp/examples/simple_sim.cpp.o"
+  "CMakeFiles/simple_sim.dir/cpp/examples/simple_sim.cpp.o.d"
+  "simple_sim"
+  "simple_sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simple_sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
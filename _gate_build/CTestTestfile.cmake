@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_gate_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[MMSUnitTests]=] "/root/repo/_gate_build/mms_tests")
+set_tests_properties([=[MMSUnitTests]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;131;add_test;/root/repo/CMakeLists.txt;0;")
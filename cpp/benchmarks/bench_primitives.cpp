@@ -0,0 +1,252 @@
+// Microbenchmarks for the book/engine primitives, isolated from agent
+// logic, RNG draws and data collection so an OrderBook change shows up
+// directly in the numbers.
+//
+// Run with JSON output for regression gating:
+//   mms_bench --benchmark_format=json > bench.json
+//   scripts/bench_compare.py baseline.json bench.json
+#include <benchmark/benchmark.h>
+
+#include "mms/matching_engine.hpp"
+#include "mms/order_book.hpp"
+#include "mms/rng.hpp"
+
+namespace {
+
+constexpr mms::Price kMidPrice = 10000;
+
+// Discards trades; keeps matching cost free of collection overhead
+class DiscardTradeSink : public mms::TradeSink {
+public:
+    void accept(const mms::Trade& trade) override { benchmark::DoNotOptimize(trade); }
+};
+
+// Fill one order per level on both sides, `depth` levels away from the mid
+void populate_book(mms::OrderBook& book, int depth, mms::Qty quantity = 100) {
+    mms::OrderId next_id = 1;
+    for (int level = 1; level <= depth; ++level) {
+        book.add_limit_order(mms::Order(next_id++, mms::Side::BUY,
+                                        kMidPrice - level, quantity, 0));
+        book.add_limit_order(mms::Order(next_id++, mms::Side::SELL,
+                                        kMidPrice + level, quantity, 0));
+    }
+}
+
+// add_limit_order of a resting (non-crossing) order at varying book
+// depths; the order is cancelled each iteration so depth stays constant.
+// The cancel cost is included but identical across depths.
+void BM_AddLimitOrder(benchmark::State& state) {
+    mms::OrderBook book;
+    populate_book(book, static_cast<int>(state.range(0)));
+
+    mms::OrderId id = 1000000;
+    for (auto _ : state) {
+        mms::Order order(id, mms::Side::BUY, kMidPrice - 1, 10, 0);
+        benchmark::DoNotOptimize(book.add_limit_order(order));
+        book.cancel_order(id);
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddLimitOrder)->Arg(16)->Arg(256)->Arg(4096);
+
+// cancel_order out of a deep level (range(0) resting orders at one
+// price); the re-add keeps the level size constant across iterations
+void BM_CancelOrderDeepLevel(benchmark::State& state) {
+    mms::OrderBook book;
+    populate_book(book, 16);
+    const mms::OrderId first_id = 1000000;
+    for (int i = 0; i < state.range(0); ++i) {
+        book.add_limit_order(mms::Order(first_id + static_cast<mms::OrderId>(i),
+                                        mms::Side::BUY, kMidPrice - 1, 10, 0));
+    }
+
+    // Cycle through the level so both front and interior removals occur
+    mms::OrderId victim = first_id;
+    const mms::OrderId last_id = first_id + static_cast<mms::OrderId>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.cancel_order(victim));
+        book.add_limit_order(mms::Order(victim, mms::Side::BUY, kMidPrice - 1, 10, 0));
+        if (++victim == last_id) {
+            victim = first_id;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CancelOrderDeepLevel)->Arg(8)->Arg(64)->Arg(512);
+
+// add_market_order sweeping range(0) ask levels; the consumed levels are
+// restored outside the timed region
+void BM_AddMarketOrderSweep(benchmark::State& state) {
+    const int swept_levels = static_cast<int>(state.range(0));
+    mms::OrderBook book;
+    populate_book(book, swept_levels + 16);
+
+    const mms::Qty sweep_quantity = 100 * swept_levels;
+    for (auto _ : state) {
+        auto trades = book.add_market_order(mms::Side::BUY, sweep_quantity, 999999, 0);
+        benchmark::DoNotOptimize(trades.data());
+
+        state.PauseTiming();
+        mms::OrderId id = 2000000;
+        for (int level = 1; level <= swept_levels; ++level) {
+            book.add_limit_order(mms::Order(id++, mms::Side::SELL,
+                                            kMidPrice + level, 100, 0));
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AddMarketOrderSweep)->Arg(1)->Arg(8)->Arg(64);
+
+void BM_TopOfBook(benchmark::State& state) {
+    mms::OrderBook book;
+    populate_book(book, 256);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book.top_of_book(0));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TopOfBook);
+
+void BM_GetDepth(benchmark::State& state) {
+    mms::OrderBook book;
+    populate_book(book, 256);
+
+    for (auto _ : state) {
+        auto depth = book.get_depth(static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(depth.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetDepth)->Arg(1)->Arg(10)->Arg(50);
+
+// MatchingEngine::process_event, one benchmark per event type, through
+// the sink API the simulator uses
+void BM_ProcessEventLimit(benchmark::State& state) {
+    mms::MatchingEngine engine;
+    for (int level = 1; level <= 64; ++level) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, static_cast<mms::OrderId>(level),
+                                        mms::Side::BUY, kMidPrice - level, 100, 0, 0));
+    }
+
+    DiscardTradeSink sink;
+    mms::OrderId id = 1000000;
+    for (auto _ : state) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, id, mms::Side::BUY,
+                                        kMidPrice - 1, 10, 0, 0), sink);
+        engine.process_event(mms::Event(mms::EventType::CANCEL, id, mms::Side::BUY,
+                                        0, 0, 0, 0), sink);
+        ++id;
+    }
+    // Each iteration is a limit plus the cancel that keeps the book stable
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ProcessEventLimit);
+
+void BM_ProcessEventMarket(benchmark::State& state) {
+    mms::MatchingEngine engine;
+    mms::OrderId maker_id = 1;
+    for (int level = 1; level <= 64; ++level) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, maker_id++, mms::Side::SELL,
+                                        kMidPrice + level, 100, 0, 0));
+    }
+
+    DiscardTradeSink sink;
+    for (auto _ : state) {
+        engine.process_event(mms::Event(mms::EventType::MARKET, 999999, mms::Side::BUY,
+                                        0, 100, 0, 0), sink);
+
+        state.PauseTiming();
+        engine.process_event(mms::Event(mms::EventType::LIMIT, maker_id++, mms::Side::SELL,
+                                        kMidPrice + 1, 100, 0, 0));
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessEventMarket);
+
+void BM_ProcessEventCancel(benchmark::State& state) {
+    mms::MatchingEngine engine;
+    for (int level = 1; level <= 64; ++level) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, static_cast<mms::OrderId>(level),
+                                        mms::Side::BUY, kMidPrice - level, 100, 0, 0));
+    }
+
+    DiscardTradeSink sink;
+    mms::OrderId id = 1000000;
+    for (auto _ : state) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, id, mms::Side::BUY,
+                                        kMidPrice - 1, 10, 0, 0), sink);
+        engine.process_event(mms::Event(mms::EventType::CANCEL, id, mms::Side::BUY,
+                                        0, 0, 0, 0), sink);
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ProcessEventCancel);
+
+// Same limit/cancel loop through the FastEngine profile, which compiles
+// the callback, stats and journal checks out of the hot path
+void BM_ProcessEventLimitFastEngine(benchmark::State& state) {
+    mms::FastEngine engine;
+    for (int level = 1; level <= 64; ++level) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, static_cast<mms::OrderId>(level),
+                                        mms::Side::BUY, kMidPrice - level, 100, 0, 0));
+    }
+
+    DiscardTradeSink sink;
+    mms::OrderId id = 1000000;
+    for (auto _ : state) {
+        engine.process_event(mms::Event(mms::EventType::LIMIT, id, mms::Side::BUY,
+                                        kMidPrice - 1, 10, 0, 0), sink);
+        engine.process_event(mms::Event(mms::EventType::CANCEL, id, mms::Side::BUY,
+                                        0, 0, 0, 0), sink);
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ProcessEventLimitFastEngine);
+
+// RNG draw costs, to separate generator overhead from engine work in
+// the end-to-end numbers
+void BM_RngUniformInt(benchmark::State& state) {
+    mms::RNG rng(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.uniform_int<int>(0, 1000));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngUniformInt);
+
+void BM_RngUniformReal(benchmark::State& state) {
+    mms::RNG rng(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.uniform_real());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngUniformReal);
+
+void BM_RngNormal(benchmark::State& state) {
+    mms::RNG rng(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.normal(0.0, 1.0));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngNormal);
+
+void BM_RngExponential(benchmark::State& state) {
+    mms::RNG rng(42);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rng.exponential(1.0));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RngExponential);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -4,6 +4,7 @@
 #include <numeric>
 #include <algorithm>
 #include "mms/simulator.hpp"
+#include "mms/multi_instrument.hpp"
 
 int main(int argc, char* argv[]) {
     std::cout << "Market Microstructure Simulator - Benchmark" << std::endl;
@@ -13,6 +14,7 @@ int main(int argc, char* argv[]) {
     size_t n_steps = 100000;
     size_t iterations = 5;
     uint64_t seed = 42;
+    size_t n_instruments = 1;
     
     if (argc > 1) {
         n_steps = std::stoul(argv[1]);
@@ -23,11 +25,15 @@ int main(int argc, char* argv[]) {
     if (argc > 3) {
         seed = std::stoull(argv[3]);
     }
+    if (argc > 4) {
+        n_instruments = std::stoul(argv[4]);
+    }
     
     std::cout << "Configuration:" << std::endl;
     std::cout << "  Steps: " << n_steps << std::endl;
     std::cout << "  Iterations: " << iterations << std::endl;
     std::cout << "  Seed: " << seed << std::endl;
+    std::cout << "  Instruments: " << n_instruments << std::endl;
     std::cout << std::endl;
     
     // Create agent configurations
@@ -57,6 +63,33 @@ int main(int argc, char* argv[]) {
     std::vector<size_t> events_per_second;
     std::vector<size_t> total_trades;
     
+    // Multi-instrument mode: measure sharded scaling across cores
+    if (n_instruments > 1) {
+        mms::MultiInstrumentConfig multi_config;
+        multi_config.n_instruments = n_instruments;
+        multi_config.base.seed = seed;
+        multi_config.base.time_step = 1000;
+        multi_config.base.output_dir.clear();
+        multi_config.maker_config = maker_config;
+        multi_config.taker_config = taker_config;
+        multi_config.noise_config = noise_config;
+
+        std::cout << "Running multi-instrument benchmark..." << std::endl;
+        for (size_t i = 0; i < iterations; ++i) {
+            mms::MultiInstrumentSimulator multi_sim(multi_config);
+            auto result = multi_sim.run(n_steps);
+            double eps = result.total_events_processed / result.wall_time_seconds;
+            std::cout << "Iteration " << (i + 1) << "/" << iterations << ": "
+                      << result.wall_time_seconds << "s, "
+                      << result.total_events_processed << " events across "
+                      << multi_sim.n_shards() << " shards ("
+                      << static_cast<size_t>(eps) << " events/s, "
+                      << result.total_trades << " trades)" << std::endl;
+        }
+        std::cout << "\nBenchmark completed!" << std::endl;
+        return 0;
+    }
+
     std::cout << "Running benchmark..." << std::endl;
     
     for (size_t i = 0; i < iterations; ++i) {
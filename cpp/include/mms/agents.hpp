@@ -3,13 +3,20 @@
 #include "types.hpp"
 #include "rng.hpp"
 #include "matching_engine.hpp"
+#include "instrumentation.hpp"
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <iosfwd>
+#include <map>
 #include <unordered_map>
 #include <string>
 
 namespace mms {
 
+// Shared buffer that batched agent populations append into
+using EventBuffer = std::vector<Event>;
+
 // Base agent interface
 class Agent {
 public:
@@ -18,6 +25,12 @@ public:
     // Generate events for the given timestamp
     virtual std::vector<Event> step(Timestamp timestamp) = 0;
     
+    // Earliest time this agent next wants to act, used by the
+    // event-driven scheduler. Returning a time at or before current_time
+    // means "no preference"; such agents are re-polled one time step
+    // later, matching the fixed-step behaviour.
+    virtual Timestamp next_event_time(Timestamp current_time) const { return current_time; }
+    
     // Get agent ID
     OrderId get_id() const { return id_; }
     
@@ -36,6 +49,12 @@ public:
     // Reset agent state
     virtual void reset() = 0;
 
+    // Checkpoint the agent's mutable state (inventory, PnL, timers,
+    // pending order IDs). Default is stateless; agents with state
+    // override both so a restored run resumes bit-exact.
+    virtual void save_state(std::ostream& /*out*/) const {}
+    virtual bool load_state(std::istream& /*in*/) { return true; }
+
 protected:
     Agent(OrderId id, const std::string& name) : id_(id), name_(name) {}
     
@@ -54,13 +73,19 @@ public:
         double inventory_penalty = 0.001; // Penalty for inventory imbalance
     };
     
+    // The RNG argument is the master generator; the agent draws from its
+    // own stream derived from (master seed, id), so results are
+    // independent of stepping order across agents.
     MarketMaker(OrderId id, const std::string& name, const Config& config, RNG& rng);
     
     std::vector<Event> step(Timestamp timestamp) override;
+    Timestamp next_event_time(Timestamp current_time) const override;
     void on_trade(const Trade& trade) override;
     double get_pnl() const override { return pnl_; }
     Qty get_inventory() const override { return inventory_; }
     void reset() override;
+    void save_state(std::ostream& out) const override;
+    bool load_state(std::istream& in) override;
     
     // Get current quotes
     Price get_bid_price() const;
@@ -71,7 +96,7 @@ public:
 
 private:
     Config config_;
-    RNG& rng_;
+    RNG rng_; // Per-agent stream
     
     // State
     Qty inventory_ = 0;
@@ -100,20 +125,26 @@ public:
         bool use_market_orders = true; // Use market orders vs aggressive limits
     };
     
+    // The RNG argument is the master generator; the agent draws from its
+    // own stream derived from (master seed, id), so results are
+    // independent of stepping order across agents.
     Taker(OrderId id, const std::string& name, const Config& config, RNG& rng);
     
     std::vector<Event> step(Timestamp timestamp) override;
+    Timestamp next_event_time(Timestamp current_time) const override;
     void on_trade(const Trade& trade) override;
     double get_pnl() const override { return pnl_; }
     Qty get_inventory() const override { return inventory_; }
     void reset() override;
+    void save_state(std::ostream& out) const override;
+    bool load_state(std::istream& in) override;
     
     // Update configuration
     void update_config(const Config& config) { config_ = config; }
 
 private:
     Config config_;
-    RNG& rng_;
+    RNG rng_; // Per-agent stream
     
     // State
     Qty inventory_ = 0;
@@ -139,20 +170,26 @@ public:
         double cancel_probability = 0.3; // Probability of canceling existing orders
     };
     
+    // The RNG argument is the master generator; the agent draws from its
+    // own stream derived from (master seed, id), so results are
+    // independent of stepping order across agents.
     NoiseTrader(OrderId id, const std::string& name, const Config& config, RNG& rng);
     
     std::vector<Event> step(Timestamp timestamp) override;
+    Timestamp next_event_time(Timestamp current_time) const override;
     void on_trade(const Trade& trade) override;
     double get_pnl() const override { return pnl_; }
     Qty get_inventory() const override { return inventory_; }
     void reset() override;
+    void save_state(std::ostream& out) const override;
+    bool load_state(std::istream& in) override;
     
     // Update configuration
     void update_config(const Config& config) { config_ = config; }
 
 private:
     Config config_;
-    RNG& rng_;
+    RNG rng_; // Per-agent stream
     
     // State
     Qty inventory_ = 0;
@@ -160,8 +197,10 @@ private:
     Timestamp next_limit_order_time_ = 0;
     Timestamp next_cancel_time_ = 0;
     
-    // Track our orders for cancellation
-    std::unordered_map<OrderId, Order> active_orders_;
+    // Track our orders for cancellation. Ordered by ID so iteration (and
+    // therefore random-cancel selection) is independent of insertion
+    // history, which keeps checkpoint restores bit-exact.
+    std::map<OrderId, Order> active_orders_;
     Price reference_price_ = 10000; // Reference price for limit orders
     
     // Helper methods
@@ -173,6 +212,156 @@ private:
     void maybe_cancel_random_order(Timestamp timestamp, std::vector<Event>& events);
 };
 
+// Self-exciting order flow driven by a multivariate Hawkes process with
+// an exponential kernel. The Poisson agents above draw independent
+// inter-arrival times, so their flow never clusters; here every arrival
+// raises the arrival rate of related streams, which then decays back
+// toward the baseline, reproducing the bursty order flow seen in real
+// markets. Buy and sell streams excite themselves and each other, and
+// both feed the cancel stream.
+//
+// The intensity of stream i is
+//     lambda_i(t) = mu_i + sum_j alpha_ij * R_j(t)
+// where R_j decays as exp(-decay * dt) between events and jumps by one
+// when stream j fires. Both the decay and the jump are O(1) recursive
+// updates on R — no scan over event history — and next-event times come
+// from Ogata thinning, so throughput matches the Poisson agents
+// regardless of how long the simulation has run. The process is
+// stationary as long as (self_excitation + cross_excitation) < decay.
+class HawkesTrader : public Agent {
+public:
+    // Event streams of the process
+    enum Stream : int { BUY = 0, SELL = 1, CANCEL = 2 };
+    static constexpr int kStreams = 3;
+
+    struct Config {
+        double mu_buy = 0.8;            // Baseline buy arrival rate
+        double mu_sell = 0.8;           // Baseline sell arrival rate
+        double mu_cancel = 0.3;         // Baseline cancel arrival rate
+        double self_excitation = 0.6;   // Same-stream kernel jump
+        double cross_excitation = 0.3;  // Opposite-side kernel jump
+        double cancel_excitation = 0.2; // Buy/sell flow -> cancel jump
+        double decay = 2.0;             // Kernel decay rate
+        Qty quantity_mean = 30;         // Mean order size
+        Qty quantity_std = 8;           // Order size standard deviation
+        Price price_volatility = 5;     // Price volatility for limit orders
+    };
+
+    // The RNG argument is the master generator; the agent draws from its
+    // own stream derived from (master seed, id), so results are
+    // independent of stepping order across agents.
+    HawkesTrader(OrderId id, const std::string& name, const Config& config, RNG& rng);
+
+    std::vector<Event> step(Timestamp timestamp) override;
+    Timestamp next_event_time(Timestamp current_time) const override;
+    void on_trade(const Trade& trade) override;
+    double get_pnl() const override { return pnl_; }
+    Qty get_inventory() const override { return inventory_; }
+    void reset() override;
+    void save_state(std::ostream& out) const override;
+    bool load_state(std::istream& in) override;
+
+    // Update configuration
+    void update_config(const Config& config) { config_ = config; }
+
+private:
+    Config config_;
+    RNG rng_; // Per-agent stream
+
+    // State
+    Qty inventory_ = 0;
+    double pnl_ = 0.0;
+
+    // O(1) Hawkes recursion state: per-stream excitation R_j, valid as of
+    // excitation_time_, plus the next scheduled arrival from thinning
+    double excitation_[kStreams] = {0.0, 0.0, 0.0};
+    Timestamp excitation_time_ = 0;
+    Timestamp next_event_time_ = 0;
+    int next_stream_ = -1;
+
+    // Track our orders for cancellation; ordered by ID so random-cancel
+    // selection is independent of insertion history (see NoiseTrader)
+    std::map<OrderId, Order> active_orders_;
+    Price reference_price_ = 10000; // Reference price for limit orders
+
+    // Helper methods
+    double stream_intensity(int stream, const double* excitation) const;
+    double total_intensity(const double* excitation) const;
+    void decay_excitation_to(Timestamp timestamp);
+    void schedule_next_event(Timestamp current_time);
+    Qty generate_order_quantity();
+    Price generate_limit_price(Side side, Price reference_price);
+};
+
+// Base interface for homogeneous agent populations. A population holds
+// the state of many identical agents in contiguous arrays and steps all
+// of them with one call into a shared event buffer, avoiding the
+// per-agent virtual call and per-step vector allocation of the Agent
+// path. Bespoke strategies should keep using Agent.
+class AgentPopulation {
+public:
+    virtual ~AgentPopulation() = default;
+
+    // Step every member once, appending generated events to the buffer
+    virtual void step_all(Timestamp timestamp, EventBuffer& events) = 0;
+
+    // Route a trade to the owning member, if any
+    virtual void on_trade(const Trade& trade) = 0;
+
+    // Number of members
+    virtual size_t size() const = 0;
+
+    // Per-member accessors for stats reporting; index is in [0, size())
+    virtual OrderId id_of(size_t index) const = 0;
+    virtual std::string name_of(size_t index) const = 0;
+    virtual double pnl_of(size_t index) const = 0;
+    virtual Qty inventory_of(size_t index) const = 0;
+
+    // Reset all members
+    virtual void reset() = 0;
+
+    // Checkpoint all member state; see Agent::save_state
+    virtual void save_state(std::ostream& /*out*/) const {}
+    virtual bool load_state(std::istream& /*in*/) { return true; }
+};
+
+// Batched equivalent of NoiseTrader: the per-agent state from
+// NoiseTrader lives in parallel arrays indexed by member, so the common
+// case (neither timer due) is a pair of contiguous loads per member.
+// Members are assigned the consecutive IDs [first_id, first_id + count).
+class NoiseTraderPopulation : public AgentPopulation {
+public:
+    NoiseTraderPopulation(OrderId first_id, size_t count,
+                          const NoiseTrader::Config& config, RNG& rng);
+
+    void step_all(Timestamp timestamp, EventBuffer& events) override;
+    void on_trade(const Trade& trade) override;
+    size_t size() const override { return inventory_.size(); }
+    OrderId id_of(size_t index) const override { return first_id_ + index; }
+    std::string name_of(size_t index) const override;
+    double pnl_of(size_t index) const override { return pnl_[index]; }
+    Qty inventory_of(size_t index) const override { return inventory_[index]; }
+    void reset() override;
+    void save_state(std::ostream& out) const override;
+    bool load_state(std::istream& in) override;
+
+private:
+    NoiseTrader::Config config_;
+    RNG rng_; // Population-owned stream (derived from first_id)
+    OrderId first_id_;
+
+    // SoA member state, all sized to the member count
+    std::vector<Qty> inventory_;
+    std::vector<double> pnl_;
+    std::vector<Timestamp> next_limit_order_time_;
+    std::vector<Timestamp> next_cancel_time_;
+    std::vector<std::vector<Order>> active_orders_;
+
+    // Maps a resting order to its owning member for trade routing
+    std::unordered_map<OrderId, size_t> order_owner_;
+    Price reference_price_ = 10000;
+};
+
 // Agent manager for coordinating multiple agents
 class AgentManager {
 public:
@@ -180,18 +369,44 @@ public:
     
     // Add an agent
     void add_agent(std::unique_ptr<Agent> agent);
-    
+
+    // Add a batched population; its members step via step_all rather
+    // than individual Agent::step calls
+    void add_population(std::unique_ptr<AgentPopulation> population);
+
     // Get agent by ID
     Agent* get_agent(OrderId id) const;
     
     // Get all agents
     const std::vector<std::unique_ptr<Agent>>& get_agents() const { return agents_; }
+
+    // Get all populations
+    const std::vector<std::unique_ptr<AgentPopulation>>& get_populations() const {
+        return populations_;
+    }
     
     // Generate events from all agents
     std::vector<Event> step(Timestamp timestamp);
+
+    // Same as above, appending into a caller-provided (e.g. arena-backed)
+    // buffer instead of returning a fresh vector
+    void step(Timestamp timestamp, std::pmr::vector<Event>& out);
+
+    // Parallel step: agents and populations are distributed across
+    // n_threads workers, each stepping into a per-agent buffer, and the
+    // buffers are merged by (timestamp, agent ID) with ties keeping each
+    // agent's generation order. Per-agent RNG streams make the output
+    // bit-identical for any thread count.
+    void step_parallel(Timestamp timestamp, std::pmr::vector<Event>& out, size_t n_threads);
     
     // Notify all agents of a trade
     void notify_trade(const Trade& trade);
+
+    // Routed variant: deliver the trade only to the maker and taker
+    // agents (resolved by the engine's open-order index) plus the
+    // populations, whose own routing is O(1). Cost is independent of the
+    // number of agents.
+    void notify_trade(const Trade& trade, OrderId maker_agent, OrderId taker_agent);
     
     // Get agent statistics
     struct AgentStats {
@@ -204,12 +419,35 @@ public:
     
     std::vector<AgentStats> get_stats() const;
     
+    // Aggregate agent-stepping latency; empty unless built with
+    // MMS_ENABLE_INSTRUMENTATION
+    std::vector<instrumentation::LatencyStats> get_latency_report() const {
+        std::vector<instrumentation::LatencyStats> report;
+#if MMS_INSTRUMENTATION
+        report.push_back(step_latency_.stats("agent_step"));
+#endif
+        return report;
+    }
+
+    // Checkpoint every agent's and population's state, in registration
+    // order; the same lineup must be registered before restoring
+    void save_state(std::ostream& out) const;
+    bool load_state(std::istream& in);
+
     // Reset all agents
     void reset();
 
+    // Remove all agents
+    void clear();
+
 private:
     std::vector<std::unique_ptr<Agent>> agents_;
+    std::vector<std::unique_ptr<AgentPopulation>> populations_;
     std::unordered_map<OrderId, Agent*> agent_lookup_;
+
+#if MMS_INSTRUMENTATION
+    instrumentation::LatencyHistogram step_latency_;
+#endif
 };
 
 } // namespace mms
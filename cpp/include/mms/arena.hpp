@@ -0,0 +1,190 @@
+#pragma once
+
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <sys/mman.h>
+
+namespace mms {
+
+// Backing mode for arena blocks. Long runs churn enough scratch memory
+// that 4K pages cost real TLB misses; 2MB huge pages cut the page walk
+// count by ~512x for the same footprint.
+enum class HugePageMode {
+    OFF,          // Plain heap blocks
+    TRANSPARENT,  // Anonymous mmap + MADV_HUGEPAGE; the kernel promotes to 2MB pages
+    EXPLICIT,     // MAP_HUGETLB from the reserved pool; falls back to
+                  // TRANSPARENT when the pool is exhausted or absent
+};
+
+// Memory placement policy for a simulation: how arena blocks are backed
+// and whether parallel sweep workers pin to CPUs. Pinned workers
+// construct their Simulator after pinning, so first-touch places each
+// run's arena, book and collector on the worker's local NUMA node.
+struct MemoryConfig {
+    HugePageMode huge_pages = HugePageMode::OFF;
+    size_t arena_block_size = 1 << 20;  // Matches Arena::kDefaultBlockSize
+    bool pin_workers = false;           // Round-robin CPU pinning in SweepRunner
+};
+
+// Per-run memory placement stats, reported in RunResult so placement can
+// be verified rather than assumed
+struct MemoryStats {
+    size_t arena_bytes_reserved = 0;  // Total arena block bytes
+    size_t arena_huge_bytes = 0;      // Portion in huge-page-backed mappings
+    int cpu = -1;                     // CPU the run finished on
+};
+
+// Per-simulation bump allocator for hot-path scratch buffers (trade lists,
+// per-step event vectors). Allocations are O(1) pointer bumps out of large
+// blocks; deallocation is a no-op and reset() rewinds to the start while
+// keeping the blocks, so a simulation that resets the arena every step
+// reaches a steady state with no malloc calls in the hot loop.
+//
+// Implemented as a std::pmr::memory_resource so std::pmr containers can be
+// backed by it directly.
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = 1 << 20; // 1 MiB
+    static constexpr size_t kHugePageSize = size_t{2} << 20; // 2 MiB
+
+    explicit Arena(size_t block_size = kDefaultBlockSize)
+        : block_size_(block_size) {}
+
+    explicit Arena(const MemoryConfig& config)
+        : block_size_(config.arena_block_size), huge_pages_(config.huge_pages) {}
+
+    // Not copyable: owns raw block storage
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override { release(); }
+
+    // Rewind to the beginning, keeping all blocks for reuse
+    void reset() {
+        current_block_ = 0;
+        current_offset_ = 0;
+        bytes_allocated_ = 0;
+    }
+
+    // Free all blocks
+    void release() {
+        for (Block& block : blocks_) {
+            destroy_block(block);
+        }
+        blocks_.clear();
+        huge_bytes_ = 0;
+        reset();
+    }
+
+    // Bytes handed out since the last reset
+    size_t bytes_allocated() const { return bytes_allocated_; }
+
+    // Total bytes held in blocks
+    size_t bytes_reserved() const {
+        size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    // Bytes held in huge-page-backed mappings (0 in OFF mode or after
+    // falling back to the heap)
+    size_t huge_page_bytes() const { return huge_bytes_; }
+
+    size_t block_count() const { return blocks_.size(); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        while (current_block_ < blocks_.size()) {
+            Block& block = blocks_[current_block_];
+            size_t aligned = align_up(current_offset_, alignment);
+            if (aligned + bytes <= block.size) {
+                current_offset_ = aligned + bytes;
+                bytes_allocated_ += bytes;
+                return block.data + aligned;
+            }
+            // Block exhausted; move to the next one
+            current_block_++;
+            current_offset_ = 0;
+        }
+
+        // Need a new block; oversized requests get a dedicated block
+        size_t new_size = std::max(block_size_, bytes + alignment);
+        blocks_.push_back(allocate_block(new_size));
+        current_block_ = blocks_.size() - 1;
+
+        size_t aligned = align_up(reinterpret_cast<uintptr_t>(blocks_.back().data), alignment) -
+                         reinterpret_cast<uintptr_t>(blocks_.back().data);
+        current_offset_ = aligned + bytes;
+        bytes_allocated_ += bytes;
+        return blocks_.back().data + aligned;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {
+        // Bump allocator: individual deallocation is a no-op
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct Block {
+        std::byte* data;
+        size_t size;
+        bool mapped;  // mmap-backed (munmap) vs heap (delete[])
+    };
+
+    Block allocate_block(size_t size) {
+        if (huge_pages_ != HugePageMode::OFF) {
+            // Round to the huge-page granule so the mapping can be
+            // promoted (or allocated) as whole 2MB pages
+            size_t rounded = align_up(size, kHugePageSize);
+            void* mapping = MAP_FAILED;
+            if (huge_pages_ == HugePageMode::EXPLICIT) {
+                mapping = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+            if (mapping == MAP_FAILED) {
+                mapping = ::mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (mapping != MAP_FAILED) {
+                    ::madvise(mapping, rounded, MADV_HUGEPAGE);
+                }
+            }
+            if (mapping != MAP_FAILED) {
+                huge_bytes_ += rounded;
+                return Block{static_cast<std::byte*>(mapping), rounded, true};
+            }
+            // mmap unavailable: fall through to the heap
+        }
+        return Block{new std::byte[size], size, false};
+    }
+
+    void destroy_block(Block& block) {
+        if (block.mapped) {
+            ::munmap(block.data, block.size);
+        } else {
+            delete[] block.data;
+        }
+        block.data = nullptr;
+    }
+
+    static size_t align_up(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    size_t block_size_;
+    HugePageMode huge_pages_ = HugePageMode::OFF;
+    std::vector<Block> blocks_;
+    size_t current_block_ = 0;
+    size_t current_offset_ = 0;
+    size_t bytes_allocated_ = 0;
+    size_t huge_bytes_ = 0;
+};
+
+} // namespace mms
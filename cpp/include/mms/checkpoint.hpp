@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace mms {
+namespace checkpoint {
+
+// Binary checkpoint file layout: a small header followed by each
+// component's state written through save_state(). Everything is
+// fixed-width little-endian PODs, so a checkpoint written every few
+// million steps is a handful of sequential writes with no formatting.
+struct CheckpointHeader {
+    char magic[4];      // "MMSK"
+    uint32_t version;
+};
+
+inline constexpr char kCheckpointMagic[4] = {'M', 'M', 'S', 'K'};
+inline constexpr uint32_t kCheckpointVersion = 1;
+
+// Raw fixed-width write/read for trivially copyable values
+template<typename T>
+void write_pod(std::ostream& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read_pod(std::istream& in, T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+} // namespace checkpoint
+} // namespace mms
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "simulator.hpp"
+#include "sweep.hpp"
+#include <vector>
+
+namespace mms {
+
+// Configuration for a paired baseline/variant (A/B) study. Both arms
+// share one seed and one SimulationConfig; the only difference is the
+// agent parameters in effect from divergence_step onwards. Steps before
+// the divergence are bit-identical by construction, so they are run once
+// and shared between the arms.
+struct DifferentialConfig {
+    SimulationConfig base;           // Shared simulation config (seed, loop mode, network)
+    size_t n_steps = 0;              // Total steps per arm
+    size_t divergence_step = 0;      // Step at which the variant configs take effect
+    AgentConfigPoint baseline;       // Agent configs for the baseline arm
+    AgentConfigPoint variant;        // Agent configs applied from the divergence step on
+};
+
+// Per-agent paired differences between the arms (variant - baseline),
+// matched by agent ID and derived from analysis::calculate_agent_performance
+struct AgentDelta {
+    OrderId agent_id = 0;
+    double pnl_delta = 0.0;
+    double sharpe_delta = 0.0;
+    double max_drawdown_delta = 0.0;
+};
+
+// Result of a differential run. `prefix` covers the shared window
+// [0, divergence_step); `baseline` and `variant` cover the
+// post-divergence window only, so every delta below is a like-for-like
+// comparison over identical simulated time under identical random draws.
+struct DifferentialResult {
+    Simulator::RunResult prefix;
+    Simulator::RunResult baseline;
+    Simulator::RunResult variant;
+    size_t divergence_step = 0;
+
+    // Paired market statistics (variant - baseline)
+    double mean_spread_delta = 0.0;
+    double median_spread_delta = 0.0;
+    double volatility_delta = 0.0;
+    double vwap_delta = 0.0;
+    int64_t trade_count_delta = 0;
+
+    // Paired per-agent performance, ordered by agent ID
+    std::vector<analysis::AgentPerformance> baseline_performance;
+    std::vector<analysis::AgentPerformance> variant_performance;
+    std::vector<AgentDelta> agent_deltas;
+};
+
+// Runs both arms of an A/B parameter study from one harness. The shared
+// prefix is simulated once under the baseline configs; the full state
+// (book, agents, RNG streams) is then forked through an in-memory
+// checkpoint, the variant parameters are swapped in, and each arm
+// resumes independently. The cost is one prefix plus two suffixes, so a
+// late divergence approaches the cost of a single run instead of two,
+// and the paired statistics come out directly instead of via an
+// external diff over dumped files.
+class DifferentialRunner {
+public:
+    explicit DifferentialRunner(const DifferentialConfig& config);
+
+    DifferentialResult run();
+
+private:
+    DifferentialConfig config_;
+};
+
+} // namespace mms
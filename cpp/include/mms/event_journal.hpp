@@ -0,0 +1,103 @@
+#pragma once
+
+#include "matching_engine.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace mms {
+
+static_assert(std::is_trivially_copyable_v<Event>,
+              "Event must stay a trivially copyable POD for journaling");
+
+// On-disk journal layout: a 24-byte header followed by a flat array of
+// raw Event structs. The file is memory-mapped on both sides, so writes
+// are plain stores into the mapping and replay reads the events in place
+// with no parsing or copying.
+struct EventJournalHeader {
+    char magic[4];          // "MMSJ"
+    uint32_t version;
+    uint32_t event_size;    // sizeof(Event) at write time
+    uint32_t reserved;
+    uint64_t count;         // Number of events in the file
+};
+
+// Append-only memory-mapped event journal writer. The backing file grows
+// by doubling (ftruncate + remap) and is trimmed to its exact size on
+// close, so append is a bounds check plus a 40-byte store in the common
+// case. Install on a MatchingEngine via set_journal() to capture the
+// exact event stream of a run.
+class EventJournalWriter {
+public:
+    explicit EventJournalWriter(const std::string& path);
+    ~EventJournalWriter();
+
+    // Not copyable: owns the file descriptor and mapping
+    EventJournalWriter(const EventJournalWriter&) = delete;
+    EventJournalWriter& operator=(const EventJournalWriter&) = delete;
+
+    void append(const Event& event);
+
+    size_t count() const { return count_; }
+    bool is_open() const { return base_ != nullptr; }
+
+    // Trim the file to its final size and unmap; called by the destructor
+    void close();
+
+private:
+    int fd_ = -1;
+    char* base_ = nullptr;
+    size_t capacity_ = 0;   // Mapped bytes
+    size_t count_ = 0;      // Events appended
+
+    void remap(size_t new_capacity);
+};
+
+// Read side: maps a journal and exposes the events as a span over the
+// file mapping (zero-copy)
+class EventJournalReader {
+public:
+    explicit EventJournalReader(const std::string& path);
+    ~EventJournalReader();
+
+    EventJournalReader(const EventJournalReader&) = delete;
+    EventJournalReader& operator=(const EventJournalReader&) = delete;
+
+    bool is_open() const { return base_ != nullptr; }
+    size_t count() const { return events_.size(); }
+    std::span<const Event> events() const { return events_; }
+
+private:
+    int fd_ = -1;
+    const char* base_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    std::span<const Event> events_;
+};
+
+// Streams a journal back through a matching engine. Replay skips agent
+// logic entirely, so it exercises the book/matching code at memory
+// bandwidth — the fast path for book-logic regression runs and for
+// benchmarking OrderBook changes in isolation.
+class ReplayDriver {
+public:
+    explicit ReplayDriver(const std::string& path) : reader_(path) {}
+
+    struct ReplayResult {
+        size_t events_replayed = 0;
+        size_t trades = 0;
+        double wall_time_seconds = 0.0;
+        double events_per_second = 0.0;
+    };
+
+    // Replay the whole journal into the given engine
+    ReplayResult replay(MatchingEngine& engine);
+
+    bool is_open() const { return reader_.is_open(); }
+    size_t count() const { return reader_.count(); }
+
+private:
+    EventJournalReader reader_;
+};
+
+} // namespace mms
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "types.hpp"
+#include "spsc_ring.hpp"
+#include <cstdint>
+
+namespace mms {
+
+// Incremental market-by-order feed, ITCH-style. The engine publishes one
+// compact message per book mutation at the mutation site — far cheaper
+// than diffing get_depth() snapshots per step — and a consumer replaying
+// the stream reconstructs the full L3 book: ADD introduces a resting
+// order, EXECUTE reports a fill against it (the order is gone once its
+// executed quantity reaches the added quantity), DELETE removes it
+// without a fill (cancel or TTL expiry).
+enum class FeedMessageType : uint8_t {
+    ADD = 1,
+    EXECUTE = 2,
+    DELETE = 3,
+};
+
+// Fixed 40-byte wire message. Timestamps are delta-encoded against the
+// previous message in the stream (saturating at 32 bits); sequence
+// numbers increase by one per message so consumers can detect gaps when
+// the ring overflows.
+struct FeedMessage {
+    uint64_t sequence = 0;
+    FeedMessageType type = FeedMessageType::ADD;
+    uint8_t side = 0;              // 0 = buy, 1 = sell (ADD/EXECUTE only)
+    uint16_t reserved = 0;
+    uint32_t timestamp_delta = 0;  // Nanoseconds since the previous message
+    OrderId order_id = 0;
+    Price price = 0;               // ADD: resting price; EXECUTE: fill price
+    Qty quantity = 0;              // ADD: resting qty; EXECUTE: fill qty
+};
+
+static_assert(sizeof(FeedMessage) == 40, "FeedMessage layout is part of the wire format");
+
+// Sequences and delta-encodes messages into a subscriber ring. The
+// engine is the single producer; one consumer thread may drain the ring
+// concurrently under the SPSC contract. A full ring drops the message
+// but still consumes its sequence number, so the gap is visible
+// downstream; dropped() counts them for the producer side.
+class FeedPublisher {
+public:
+    explicit FeedPublisher(size_t capacity) : ring_(capacity) {}
+
+    void publish_add(const Order& order) {
+        FeedMessage message = next_message(FeedMessageType::ADD, order.timestamp);
+        message.side = order.side == Side::SELL ? 1 : 0;
+        message.order_id = order.id;
+        message.price = order.price;
+        message.quantity = order.quantity;
+        push(message);
+    }
+
+    void publish_execute(OrderId order_id, Side maker_side, Price price, Qty quantity,
+                         Timestamp timestamp) {
+        FeedMessage message = next_message(FeedMessageType::EXECUTE, timestamp);
+        message.side = maker_side == Side::SELL ? 1 : 0;
+        message.order_id = order_id;
+        message.price = price;
+        message.quantity = quantity;
+        push(message);
+    }
+
+    void publish_delete(OrderId order_id, Timestamp timestamp) {
+        FeedMessage message = next_message(FeedMessageType::DELETE, timestamp);
+        message.order_id = order_id;
+        push(message);
+    }
+
+    SPSCRing<FeedMessage>& ring() { return ring_; }
+
+    // Messages published so far (next sequence number)
+    uint64_t sequence() const { return sequence_; }
+
+    // Messages lost to a full ring
+    uint64_t dropped() const { return dropped_; }
+
+private:
+    FeedMessage next_message(FeedMessageType type, Timestamp timestamp) {
+        FeedMessage message;
+        message.sequence = sequence_++;
+        message.type = type;
+        Timestamp delta = timestamp - last_timestamp_;
+        if (delta < 0) {
+            delta = 0;
+        }
+        message.timestamp_delta = delta > static_cast<Timestamp>(UINT32_MAX)
+                                      ? UINT32_MAX
+                                      : static_cast<uint32_t>(delta);
+        last_timestamp_ = timestamp;
+        return message;
+    }
+
+    void push(const FeedMessage& message) {
+        if (!ring_.try_push(message)) {
+            dropped_++;
+        }
+    }
+
+    SPSCRing<FeedMessage> ring_;
+    uint64_t sequence_ = 0;
+    uint64_t dropped_ = 0;
+    Timestamp last_timestamp_ = 0;
+};
+
+} // namespace mms
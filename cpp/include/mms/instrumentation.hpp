@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define MMS_HAS_RDTSC 1
+#else
+#define MMS_HAS_RDTSC 0
+#endif
+
+// Opt-in hot-path instrumentation. Build with -DMMS_ENABLE_INSTRUMENTATION=ON
+// (which defines MMS_INSTRUMENTATION) to time the matching paths and agent
+// stepping with rdtsc; without the flag every timing site compiles away and
+// the reporting APIs return empty results.
+#ifndef MMS_INSTRUMENTATION
+#define MMS_INSTRUMENTATION 0
+#endif
+
+namespace mms {
+namespace instrumentation {
+
+// Raw cycle counter; falls back to steady_clock off x86
+inline uint64_t read_cycle_counter() {
+#if MMS_HAS_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Cycles-per-nanosecond ratio, calibrated once against steady_clock on
+// first use (a few milliseconds of spinning)
+inline double cycles_per_ns() {
+    static const double ratio = [] {
+#if MMS_HAS_RDTSC
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t cycles_start = read_cycle_counter();
+        while (std::chrono::steady_clock::now() - wall_start <
+               std::chrono::milliseconds(5)) {
+        }
+        uint64_t cycles_end = read_cycle_counter();
+        auto wall_end = std::chrono::steady_clock::now();
+        auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              wall_end - wall_start).count();
+        return static_cast<double>(cycles_end - cycles_start) /
+               static_cast<double>(elapsed_ns);
+#else
+        return 1.0; // Counter already in nanoseconds
+#endif
+    }();
+    return ratio;
+}
+
+// Summary row exported per timing site
+struct LatencyStats {
+    std::string name;
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+};
+
+// HDR-style log-bucketed histogram of nanosecond durations. Values are
+// bucketed by their leading bit with 16 linear sub-buckets per power of
+// two (~6% relative resolution), so record() is a couple of bit
+// operations and an array increment, and memory stays constant
+// regardless of sample count.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+    static constexpr size_t kGroups = 64 - kSubBucketBits + 1;
+    static constexpr size_t kBuckets = kGroups * kSubBuckets;
+
+    void record(uint64_t value_ns) {
+        buckets_[bucket_index(value_ns)]++;
+        count_++;
+        min_ = count_ == 1 ? value_ns : std::min(min_, value_ns);
+        max_ = std::max(max_, value_ns);
+    }
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ > 0 ? min_ : 0; }
+    uint64_t max() const { return max_; }
+
+    // Lower bound of the bucket containing the requested percentile
+    // (fraction in [0, 1]); exact to the ~6% bucket resolution
+    uint64_t value_at_percentile(double fraction) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(count_));
+        if (target >= count_) {
+            target = count_ - 1;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i];
+            if (seen > target) {
+                return bucket_value(i);
+            }
+        }
+        return max_;
+    }
+
+    LatencyStats stats(const std::string& name) const {
+        LatencyStats result;
+        result.name = name;
+        result.count = count_;
+        result.min_ns = min();
+        result.max_ns = max_;
+        result.p50_ns = value_at_percentile(0.50);
+        result.p99_ns = value_at_percentile(0.99);
+        result.p999_ns = value_at_percentile(0.999);
+        return result;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBuckets; ++i) {
+            buckets_[i] += other.buckets_[i];
+        }
+        if (other.count_ > 0) {
+            min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+            count_ += other.count_;
+        }
+    }
+
+    void clear() {
+        buckets_.fill(0);
+        count_ = 0;
+        min_ = 0;
+        max_ = 0;
+    }
+
+    static size_t bucket_index(uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<size_t>(value);
+        }
+        int msb = 63 - __builtin_clzll(value);
+        size_t group = static_cast<size_t>(msb - kSubBucketBits + 1);
+        uint64_t sub = (value >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+        return group * kSubBuckets + static_cast<size_t>(sub);
+    }
+
+    static uint64_t bucket_value(size_t index) {
+        size_t group = index / static_cast<size_t>(kSubBuckets);
+        uint64_t sub = index % kSubBuckets;
+        if (group == 0) {
+            return sub;
+        }
+        return (kSubBuckets + sub) << (group - 1);
+    }
+
+private:
+    std::array<uint64_t, kBuckets> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t min_ = 0;
+    uint64_t max_ = 0;
+};
+
+// Times a scope with rdtsc and records the elapsed nanoseconds into a
+// histogram on destruction. Only instantiated inside
+// MMS_INSTRUMENTATION-guarded blocks.
+class ScopedLatencyTimer {
+public:
+    explicit ScopedLatencyTimer(LatencyHistogram& histogram)
+        : histogram_(histogram), start_(read_cycle_counter()) {}
+
+    ~ScopedLatencyTimer() {
+        uint64_t elapsed = read_cycle_counter() - start_;
+        histogram_.record(static_cast<uint64_t>(
+            static_cast<double>(elapsed) / cycles_per_ns()));
+    }
+
+    ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+    ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    uint64_t start_;
+};
+
+} // namespace instrumentation
+} // namespace mms
@@ -2,12 +2,31 @@
 
 #include "types.hpp"
 #include "order_book.hpp"
+#include "arena.hpp"
+#include "feed.hpp"
+#include "instrumentation.hpp"
+#include "checkpoint.hpp"
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <functional>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mms {
 
+class EventJournalWriter;
+struct Event;
+
+namespace detail {
+// Out-of-line append (defined with the journal) so the writer type can
+// stay forward-declared in this header
+void journal_append(EventJournalWriter* journal, const Event& event);
+}
+
 // Event structure for the matching engine
 struct Event {
     EventType type;
@@ -17,73 +36,472 @@ struct Event {
     Qty quantity;
     Timestamp timestamp;
     OrderId agent_id; // Which agent generated this event
-    
+
     Event() = default;
-    Event(EventType type, OrderId order_id, Side side, Price price, Qty quantity, 
+    Event(EventType type, OrderId order_id, Side side, Price price, Qty quantity,
           Timestamp timestamp, OrderId agent_id)
-        : type(type), order_id(order_id), side(side), price(price), 
+        : type(type), order_id(order_id), side(side), price(price),
           quantity(quantity), timestamp(timestamp), agent_id(agent_id) {}
 };
 
-// Matching engine that processes events and maintains order book
-class MatchingEngine {
+// Receiver for trades produced by the matching paths. Implementations are
+// caller-provided (flat buffer, callback, collector, ...) so batch event
+// ingestion does not have to build and concatenate per-event vectors.
+class TradeSink {
+public:
+    virtual ~TradeSink() = default;
+    virtual void accept(const Trade& trade) = 0;
+};
+
+// Sink appending into an existing trade buffer (not cleared by the engine)
+class VectorTradeSink : public TradeSink {
+public:
+    explicit VectorTradeSink(TradeList& out) : out_(out) {}
+    void accept(const Trade& trade) override { out_.push_back(trade); }
+
+private:
+    TradeList& out_;
+};
+
+// Engine policies. Each policy is a plain struct the engine embeds; an
+// enabled policy carries the state for its feature, a disabled one is
+// empty and compiles the feature's per-event checks out entirely (the
+// branch sits inside `if constexpr`, so not even the null test remains).
+
+// Callback policy: type-erased monitoring callbacks invoked per trade
+// and per accepted order
+struct DynamicCallbacks {
+    static constexpr bool enabled = true;
+    std::function<void(const Trade&)> trade;
+    std::function<void(const Trade&, OrderId, OrderId)> routed_trade;
+    std::function<void(const Order&)> order;
+};
+
+struct NoCallbacks {
+    static constexpr bool enabled = false;
+};
+
+// Stats policy: per-event-type matching latency histograms (which also
+// require building with MMS_ENABLE_INSTRUMENTATION)
+struct FullStats {
+    static constexpr bool enabled = true;
+#if MMS_INSTRUMENTATION
+    instrumentation::LatencyHistogram limit_latency;
+    instrumentation::LatencyHistogram market_latency;
+    instrumentation::LatencyHistogram cancel_latency;
+#endif
+};
+
+struct MinimalStats {
+    static constexpr bool enabled = false;
+};
+
+// Journal policy: append-only event capture (see event_journal.hpp)
+struct DynamicJournal {
+    static constexpr bool enabled = true;
+    EventJournalWriter* writer = nullptr;
+};
+
+struct NoJournal {
+    static constexpr bool enabled = false;
+};
+
+// Matching engine that processes events and maintains the order book.
+// The policy parameters select, at compile time, which optional
+// machinery the hot loop pays for; see the MatchingEngine and FastEngine
+// aliases below for the two supported profiles.
+template <class CallbackPolicy = DynamicCallbacks,
+          class StatsPolicy = FullStats,
+          class JournalPolicy = DynamicJournal>
+class BasicMatchingEngine {
 public:
-    MatchingEngine() = default;
-    
+    BasicMatchingEngine() = default;
+
     // Process a single event and return any trades that occurred
-    std::vector<Trade> process_event(const Event& event);
-    
-    // Process multiple events in sequence
-    std::vector<Trade> process_events(const std::vector<Event>& events);
-    
+    TradeList process_event(const Event& event) {
+        if constexpr (JournalPolicy::enabled) {
+            if (journal_.writer != nullptr) {
+                detail::journal_append(journal_.writer, event);
+            }
+        }
+        switch (event.type) {
+            case EventType::LIMIT:
+                return process_limit_order(event);
+            case EventType::MARKET:
+                return process_market_order(event);
+            case EventType::CANCEL:
+                return process_cancel_order(event);
+            default:
+                return TradeList(memory_); // Unknown event type
+        }
+    }
+
+    // Process a single event, reporting trades to the sink
+    void process_event(const Event& event, TradeSink& sink) {
+        auto trades = process_event(event);
+        for (const auto& trade : trades) {
+            sink.accept(trade);
+        }
+    }
+
+    // Batch ingestion: process events in sequence, reporting trades to the
+    // sink with no per-event vector construction
+    void process_events(std::span<const Event> events, TradeSink& sink) {
+        for (const auto& event : events) {
+            process_event(event, sink);
+        }
+    }
+
+    // Process multiple events in sequence (thin wrappers over the batch API)
+    TradeList process_events(const std::vector<Event>& events) {
+        TradeList all_trades(memory_);
+        VectorTradeSink sink(all_trades);
+        process_events(std::span<const Event>(events.data(), events.size()), sink);
+        return all_trades;
+    }
+
+    TradeList process_events(const std::pmr::vector<Event>& events) {
+        TradeList all_trades(memory_);
+        VectorTradeSink sink(all_trades);
+        process_events(std::span<const Event>(events.data(), events.size()), sink);
+        return all_trades;
+    }
+
+    // Capture every processed event into an append-only memory-mapped
+    // journal (see event_journal.hpp); nullptr disables capture
+    void set_journal(EventJournalWriter* journal) {
+        static_assert(JournalPolicy::enabled,
+                      "this engine specialization compiles journaling out");
+        journal_.writer = journal;
+    }
+
+    // Back all trade buffers with an external memory resource (e.g. the
+    // simulation arena). The caller owns the resource and must keep it
+    // alive for the lifetime of the engine.
+    void set_memory_resource(std::pmr::memory_resource* memory) {
+        memory_ = memory;
+        order_book_.set_memory_resource(memory);
+    }
+
     // Get current market snapshot
     MarketSnapshot get_market_snapshot(Timestamp timestamp) const {
         return order_book_.top_of_book(timestamp);
     }
-    
+
     // Get order book depth
     std::vector<PriceLevel> get_depth(int levels = 10) const {
         return order_book_.get_depth(levels);
     }
-    
+
     // Get order book reference (for direct access if needed)
     const OrderBook& get_order_book() const { return order_book_; }
     OrderBook& get_order_book() { return order_book_; }
-    
+
     // Get statistics
     size_t order_count() const { return order_book_.size(); }
     Price last_trade_price() const { return order_book_.last_trade_price(); }
     Qty total_volume() const { return order_book_.total_volume(); }
     size_t trade_count() const { return order_book_.trade_count(); }
-    
+
+    // Per-event-type matching latency percentiles; empty unless the stats
+    // policy is enabled and the build has MMS_ENABLE_INSTRUMENTATION
+    std::vector<instrumentation::LatencyStats> get_latency_report() const {
+        std::vector<instrumentation::LatencyStats> report;
+#if MMS_INSTRUMENTATION
+        if constexpr (StatsPolicy::enabled) {
+            report.push_back(stats_.limit_latency.stats("process_limit_order"));
+            report.push_back(stats_.market_latency.stats("process_market_order"));
+            report.push_back(stats_.cancel_latency.stats("process_cancel_order"));
+        }
+#endif
+        return report;
+    }
+
+    // Serialize the book plus the per-agent open-order index
+    void save_state(std::ostream& out) const {
+        order_book_.save_state(out);
+        checkpoint::write_pod(out, static_cast<uint64_t>(order_agent_.size()));
+        for (const auto& [order_id, agent_id] : order_agent_) {
+            checkpoint::write_pod(out, order_id);
+            checkpoint::write_pod(out, agent_id);
+        }
+    }
+
+    bool load_state(std::istream& in) {
+        if (!order_book_.load_state(in)) {
+            return false;
+        }
+        order_agent_.clear();
+        agent_open_orders_.clear();
+        uint64_t n_entries = 0;
+        if (!checkpoint::read_pod(in, n_entries)) {
+            return false;
+        }
+        for (uint64_t i = 0; i < n_entries; ++i) {
+            OrderId order_id = 0;
+            OrderId agent_id = 0;
+            if (!checkpoint::read_pod(in, order_id) || !checkpoint::read_pod(in, agent_id)) {
+                return false;
+            }
+            order_agent_[order_id] = agent_id;
+            agent_open_orders_[agent_id].insert(order_id);
+        }
+        return true;
+    }
+
     // Clear the engine (reset state)
-    void clear() { order_book_.clear(); }
-    
+    void clear() {
+        order_book_.clear();
+        order_agent_.clear();
+        agent_open_orders_.clear();
+    }
+
+    // Skip matching incoming orders against the same agent's resting
+    // orders (they stay untouched in the queue) instead of self-filling;
+    // no cancel round-trips are generated
+    void set_self_trade_prevention(bool enabled) { self_trade_prevention_ = enabled; }
+
+    // Forward admission/eviction limits to the book
+    void set_admission_config(const AdmissionConfig& config) {
+        order_book_.set_admission_config(config);
+    }
+
+    // Attach an incremental feed publisher (nullptr detaches). Every
+    // book mutation then emits a sequenced ADD/EXECUTE/DELETE message at
+    // the mutation site; see feed.hpp for the stream semantics.
+    void set_feed_publisher(FeedPublisher* feed) { feed_ = feed; }
+    bool self_trade_prevention() const { return self_trade_prevention_; }
+
+    // Agent that owns a resting order, if it is still in the book
+    std::optional<OrderId> agent_of(OrderId order_id) const {
+        auto it = order_agent_.find(order_id);
+        if (it == order_agent_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    // Number of resting orders owned by an agent
+    size_t open_order_count(OrderId agent_id) const {
+        auto it = agent_open_orders_.find(agent_id);
+        return it != agent_open_orders_.end() ? it->second.size() : 0;
+    }
+
+    // Trade callback that also carries the maker and taker agent IDs, so
+    // notifications can be routed to the two involved agents instead of
+    // broadcast to every agent
+    void set_routed_trade_callback(
+        std::function<void(const Trade&, OrderId, OrderId)> callback) {
+        static_assert(CallbackPolicy::enabled,
+                      "this engine specialization compiles callbacks out");
+        callbacks_.routed_trade = std::move(callback);
+    }
+
     // Set trade callback for external monitoring
     void set_trade_callback(std::function<void(const Trade&)> callback) {
-        trade_callback_ = std::move(callback);
+        static_assert(CallbackPolicy::enabled,
+                      "this engine specialization compiles callbacks out");
+        callbacks_.trade = std::move(callback);
     }
-    
+
     // Set order callback for external monitoring
     void set_order_callback(std::function<void(const Order&)> callback) {
-        order_callback_ = std::move(callback);
+        static_assert(CallbackPolicy::enabled,
+                      "this engine specialization compiles callbacks out");
+        callbacks_.order = std::move(callback);
     }
 
 private:
     OrderBook order_book_;
-    std::vector<Trade> trades_;
-    
-    // Callbacks for external monitoring
-    std::function<void(const Trade&)> trade_callback_;
-    std::function<void(const Order&)> order_callback_;
-    
+
+    // Memory resource for trade buffers returned by value
+    std::pmr::memory_resource* memory_ = std::pmr::get_default_resource();
+
+    // Optional incremental feed publisher
+    FeedPublisher* feed_ = nullptr;
+
+    // Policy state; disabled policies are empty and take no space
+    [[no_unique_address]] CallbackPolicy callbacks_;
+    [[no_unique_address]] StatsPolicy stats_;
+    [[no_unique_address]] JournalPolicy journal_;
+
+    // Per-agent open-order index: resting order -> owning agent, and the
+    // reverse per-agent ID sets used both for trade routing and as the
+    // self-trade-prevention exclusion set
+    bool self_trade_prevention_ = false;
+    std::unordered_map<OrderId, OrderId> order_agent_;
+    std::unordered_map<OrderId, std::unordered_set<OrderId>> agent_open_orders_;
+
     // Helper methods
-    std::vector<Trade> process_limit_order(const Event& event);
-    std::vector<Trade> process_market_order(const Event& event);
-    std::vector<Trade> process_cancel_order(const Event& event);
-    
-    void notify_trade(const Trade& trade);
-    void notify_order(const Order& order);
+    TradeList process_limit_order(const Event& event) {
+#if MMS_INSTRUMENTATION
+        std::optional<instrumentation::ScopedLatencyTimer> timer;
+        if constexpr (StatsPolicy::enabled) {
+            timer.emplace(stats_.limit_latency);
+        }
+#endif
+        TradeList trades(memory_);
+
+        // Create order from event
+        Order order(event.order_id, event.side, event.price, event.quantity, event.timestamp);
+
+        // The book matches crossing orders immediately and rests the remainder
+        const std::unordered_set<OrderId>* excluded = excluded_makers_for(event.agent_id);
+        if (order_book_.add_limit_order(order, trades, excluded)) {
+            notify_order(order);
+            // Index the order by agent if any of it rested
+            if (auto rested = order_book_.get_order(event.order_id)) {
+                order_agent_[event.order_id] = event.agent_id;
+                agent_open_orders_[event.agent_id].insert(event.order_id);
+                if (feed_ != nullptr) {
+                    publish_feed_trades(trades, event.side, event.timestamp);
+                    feed_->publish_add(*rested); // Executions precede the resting remainder
+                }
+            } else if (feed_ != nullptr) {
+                publish_feed_trades(trades, event.side, event.timestamp);
+            }
+        }
+
+        // Notify trades, then drop fully consumed makers from the index (in
+        // that order, so notification can still resolve the maker's agent)
+        for (const auto& trade : trades) {
+            notify_trade(trade, event.agent_id);
+        }
+        for (const auto& trade : trades) {
+            if (!order_book_.get_order(trade.maker_id)) {
+                release_order(trade.maker_id);
+            }
+        }
+        release_expired_orders(event.timestamp);
+
+        return trades;
+    }
+
+    TradeList process_market_order(const Event& event) {
+#if MMS_INSTRUMENTATION
+        std::optional<instrumentation::ScopedLatencyTimer> timer;
+        if constexpr (StatsPolicy::enabled) {
+            timer.emplace(stats_.market_latency);
+        }
+#endif
+        // Execute market order immediately
+        TradeList trades = order_book_.add_market_order(
+            event.side, event.quantity, event.order_id, event.timestamp,
+            excluded_makers_for(event.agent_id)
+        );
+        if (feed_ != nullptr) {
+            publish_feed_trades(trades, event.side, event.timestamp);
+        }
+
+        // Notify trades, then drop fully consumed makers from the index
+        for (const auto& trade : trades) {
+            notify_trade(trade, event.agent_id);
+        }
+        for (const auto& trade : trades) {
+            if (!order_book_.get_order(trade.maker_id)) {
+                release_order(trade.maker_id);
+            }
+        }
+        release_expired_orders(event.timestamp);
+
+        return trades;
+    }
+
+    TradeList process_cancel_order(const Event& event) {
+#if MMS_INSTRUMENTATION
+        std::optional<instrumentation::ScopedLatencyTimer> timer;
+        if constexpr (StatsPolicy::enabled) {
+            timer.emplace(stats_.cancel_latency);
+        }
+#endif
+        TradeList trades(memory_); // Cancels don't generate trades
+
+        // Cancel the order
+        if (order_book_.cancel_order(event.order_id)) {
+            release_order(event.order_id);
+            if (feed_ != nullptr) {
+                feed_->publish_delete(event.order_id, event.timestamp);
+            }
+        }
+
+        return trades;
+    }
+
+    // Exclusion set for an incoming order when STP is on, or nullptr
+    const std::unordered_set<OrderId>* excluded_makers_for(OrderId agent_id) const {
+        if (!self_trade_prevention_) {
+            return nullptr;
+        }
+        auto it = agent_open_orders_.find(agent_id);
+        return it != agent_open_orders_.end() && !it->second.empty() ? &it->second : nullptr;
+    }
+
+    // Drop a resting order from the per-agent index
+    void release_order(OrderId order_id) {
+        auto it = order_agent_.find(order_id);
+        if (it == order_agent_.end()) {
+            return;
+        }
+        auto open_it = agent_open_orders_.find(it->second);
+        if (open_it != agent_open_orders_.end()) {
+            open_it->second.erase(order_id);
+        }
+        order_agent_.erase(it);
+    }
+
+    // Drop TTL-expired makers from the agent index after matching
+    void release_expired_orders(Timestamp timestamp) {
+        if (order_book_.expired_order_ids().empty()) {
+            return;
+        }
+        for (OrderId order_id : order_book_.expired_order_ids()) {
+            release_order(order_id);
+            if (feed_ != nullptr) {
+                feed_->publish_delete(order_id, timestamp);
+            }
+        }
+        order_book_.clear_expired_order_ids();
+    }
+
+    // Emit one EXECUTE feed message per fill; callers check feed_ first
+    void publish_feed_trades(const TradeList& trades, Side taker_side, Timestamp timestamp) {
+        // One EXECUTE per fill against the resting maker; the maker sits on
+        // the opposite side of the taker
+        Side maker_side = taker_side == Side::BUY ? Side::SELL : Side::BUY;
+        for (const auto& trade : trades) {
+            feed_->publish_execute(trade.maker_id, maker_side, trade.price, trade.quantity,
+                                   timestamp);
+        }
+    }
+
+    void notify_trade(const Trade& trade, OrderId taker_agent) {
+        if constexpr (CallbackPolicy::enabled) {
+            if (callbacks_.routed_trade) {
+                auto maker_it = order_agent_.find(trade.maker_id);
+                OrderId maker_agent = maker_it != order_agent_.end() ? maker_it->second : 0;
+                callbacks_.routed_trade(trade, maker_agent, taker_agent);
+            }
+            if (callbacks_.trade) {
+                callbacks_.trade(trade);
+            }
+        }
+    }
+
+    void notify_order(const Order& order) {
+        if constexpr (CallbackPolicy::enabled) {
+            if (callbacks_.order) {
+                callbacks_.order(order);
+            }
+        }
+    }
 };
 
+// Default profile: the flexible engine with runtime-configurable
+// callbacks, stats and journaling, as used by the Simulator
+using MatchingEngine = BasicMatchingEngine<DynamicCallbacks, FullStats, DynamicJournal>;
+
+// Throughput profile for sweeps: no callback, stats or journal checks
+// survive compilation; book behavior is identical to MatchingEngine
+using FastEngine = BasicMatchingEngine<NoCallbacks, MinimalStats, NoJournal>;
+
 } // namespace mms
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "simulator.hpp"
+#include <vector>
+#include <string>
+
+namespace mms {
+
+// Configuration for a multi-instrument run. Every instrument gets its own
+// Simulator (engine, book, agents, arena) with a seed derived from the
+// base seed plus the instrument id, so runs are deterministic regardless
+// of how instruments are sharded across threads.
+struct MultiInstrumentConfig {
+    size_t n_instruments = 16;
+    size_t n_threads = 0;                  // 0 = one shard per hardware core
+    SimulationConfig base;                 // Per-instrument simulation config
+    MarketMaker::Config maker_config;
+    Taker::Config taker_config;
+    NoiseTrader::Config noise_config;
+};
+
+// Runs N independent instruments sharded across a pool of threads, one
+// shard per core with instruments pinned to shards. Instruments within a
+// shard run sequentially on the shard's thread; shards run in parallel
+// with no shared mutable state, so scaling is limited only by core count
+// and memory bandwidth.
+class MultiInstrumentSimulator {
+public:
+    explicit MultiInstrumentSimulator(const MultiInstrumentConfig& config);
+
+    // Trade tagged with the instrument that produced it, for the merged
+    // cross-instrument stream
+    struct InstrumentTrade {
+        size_t instrument_id;
+        Trade trade;
+    };
+
+    struct RunResult {
+        std::vector<Simulator::RunResult> instruments;  // Indexed by instrument id
+        std::vector<InstrumentTrade> merged_trades;     // Timestamp-ordered across instruments
+        size_t total_events_processed = 0;
+        size_t total_trades = 0;
+        double wall_time_seconds = 0.0;
+    };
+
+    RunResult run(size_t n_steps);
+
+    size_t n_instruments() const { return config_.n_instruments; }
+    size_t n_shards() const { return n_shards_; }
+
+private:
+    MultiInstrumentConfig config_;
+    size_t n_shards_;
+
+    // Merge per-instrument trade streams into one timestamp-ordered stream
+    // (ties broken by instrument id for determinism)
+    static std::vector<InstrumentTrade> merge_trades(const std::vector<Simulator::RunResult>& results);
+};
+
+} // namespace mms
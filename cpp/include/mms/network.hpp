@@ -0,0 +1,160 @@
+#pragma once
+
+#include "types.hpp"
+#include "matching_engine.hpp"
+#include "rng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace mms {
+
+// One-way agent-to-exchange delay distribution. With NONE (the default)
+// events reach the engine instantly within the step, as before; the
+// other models delay each event by a sampled number of nanoseconds, so
+// latency races — a maker's cancel against a taker's aggression — play
+// out by arrival time instead of submission order.
+enum class DelayModel {
+    NONE,       // No delay: events are matched as they are generated
+    FIXED,      // Constant one-way delay
+    LOGNORMAL,  // exp(N(mu, sigma)) nanoseconds, the usual wire-latency shape
+    EMPIRICAL,  // Drawn uniformly from a calibrated sample of delays
+};
+
+struct DelayConfig {
+    DelayModel model = DelayModel::NONE;
+    Timestamp fixed_delay = 0;                // FIXED: delay in nanoseconds
+    double lognormal_mu = 0.0;                // LOGNORMAL: mean of log-delay (log ns)
+    double lognormal_sigma = 0.0;             // LOGNORMAL: std dev of log-delay
+    std::vector<Timestamp> empirical_delays;  // EMPIRICAL: measured delays to draw from
+};
+
+// Network configuration: one default distribution plus per-agent
+// overrides keyed by agent ID. Applies to the sequential and
+// event-driven loops; the pipelined loop keeps instant delivery.
+struct NetworkConfig {
+    DelayConfig default_delay;
+    std::unordered_map<OrderId, DelayConfig> agent_delays;
+
+    bool enabled() const {
+        if (default_delay.model != DelayModel::NONE) {
+            return true;
+        }
+        for (const auto& [agent_id, delay] : agent_delays) {
+            if (delay.model != DelayModel::NONE) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// Samples per-agent one-way delays. Draws come from a dedicated RNG
+// stream derived from the master seed, so enabling the network layer
+// does not perturb any agent's own random sequence.
+class NetworkModel {
+public:
+    NetworkModel() = default;
+
+    void reset(const NetworkConfig& config, const RNG& master) {
+        config_ = config;
+        enabled_ = config.enabled();
+        rng_ = master.stream(kNetworkRngStream);
+    }
+
+    bool enabled() const { return enabled_; }
+
+    Timestamp sample_delay(OrderId agent_id) {
+        const DelayConfig* delay = &config_.default_delay;
+        auto it = config_.agent_delays.find(agent_id);
+        if (it != config_.agent_delays.end()) {
+            delay = &it->second;
+        }
+        switch (delay->model) {
+            case DelayModel::FIXED:
+                return delay->fixed_delay;
+            case DelayModel::LOGNORMAL:
+                return static_cast<Timestamp>(
+                    std::exp(rng_.normal(delay->lognormal_mu, delay->lognormal_sigma)));
+            case DelayModel::EMPIRICAL: {
+                if (delay->empirical_delays.empty()) {
+                    return 0;
+                }
+                size_t index =
+                    rng_.uniform_int<size_t>(0, delay->empirical_delays.size() - 1);
+                return delay->empirical_delays[index];
+            }
+            default:
+                return 0;
+        }
+    }
+
+private:
+    // Stream ID far outside the agent-ID range
+    static constexpr uint64_t kNetworkRngStream = ~uint64_t{0};
+
+    NetworkConfig config_;
+    RNG rng_;
+    bool enabled_ = false;
+};
+
+// Timestamp-ordered queue of in-flight events, used by the scheduler to
+// interleave delayed deliveries with agent wakeups. Backed by a single
+// contiguous vector managed as a binary heap, so push and pop are
+// O(log n) with no per-event allocation once the storage has grown to
+// its working size. A sequence number breaks delivery-time ties in send
+// order, keeping equal-delay events in their original interleaving.
+class PendingEventQueue {
+public:
+    void reserve(size_t n_events) { heap_.reserve(n_events); }
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+    // Earliest delivery time; only valid when not empty
+    Timestamp next_time() const { return heap_.front().deliver_time; }
+
+    void push(const Event& event, Timestamp deliver_time) {
+        heap_.push_back(Entry{deliver_time, next_sequence_++, event});
+        std::push_heap(heap_.begin(), heap_.end(), Later{});
+    }
+
+    // Pop the earliest event into `out` if it is due at or before `now`
+    bool pop_due(Timestamp now, Event& out) {
+        if (heap_.empty() || heap_.front().deliver_time > now) {
+            return false;
+        }
+        out = heap_.front().event;
+        std::pop_heap(heap_.begin(), heap_.end(), Later{});
+        heap_.pop_back();
+        return true;
+    }
+
+    void clear() {
+        heap_.clear();
+        next_sequence_ = 0;
+    }
+
+private:
+    struct Entry {
+        Timestamp deliver_time;
+        uint64_t sequence;
+        Event event;
+    };
+
+    // Min-heap order: earliest delivery first, then send order
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.deliver_time != b.deliver_time) {
+                return a.deliver_time > b.deliver_time;
+            }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    std::vector<Entry> heap_;
+    uint64_t next_sequence_ = 0;
+};
+
+} // namespace mms
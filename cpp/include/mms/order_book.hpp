@@ -1,146 +1,385 @@
 #pragma once
 
 #include "types.hpp"
+#include <array>
+#include <iosfwd>
 #include <map>
-#include <deque>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
 
 namespace mms {
 
-// Price level container for maintaining order queues
+// Index of an order node in the book's node pool
+using OrderNodeIndex = uint32_t;
+inline constexpr OrderNodeIndex kNullOrderNode = UINT32_MAX;
+
+// Trade buffer type for the matching paths. Backed by the simulation's
+// Arena when one is installed via set_memory_resource(), otherwise by the
+// default heap resource.
+using TradeList = std::pmr::vector<Trade>;
+
+// Pool-allocated order node forming an intrusive doubly-linked list per
+// price level. Links are pool indices (not pointers) so the pool can grow
+// without invalidating them.
+struct OrderNode {
+    Order order;
+    OrderNodeIndex prev = kNullOrderNode;
+    OrderNodeIndex next = kNullOrderNode;
+    uint32_t arrival = 0;  // Level-local arrival slot (1-based), for queue queries
+};
+
+// Price level maintaining a FIFO queue of order nodes. The level only
+// stores list endpoints and aggregates; the nodes themselves live in the
+// book's shared pool, so add/remove are O(1) with no element shuffling.
+//
+// Alongside the list, the level keeps a Fenwick tree over arrival slots
+// so "quantity ahead of this order" is an O(log n) prefix sum instead of
+// a queue walk. Each arrival takes the next slot; fills and cancels
+// subtract from the order's slot, so the prefix stays exact no matter
+// where in the queue the removal happened. Slots are recycled when the
+// level empties.
 class OrderBookPriceLevel {
 public:
     OrderBookPriceLevel() = default;
-    
-    void add_order(const Order& order) {
-        orders_.push_back(order);
-        total_quantity_ += order.quantity;
-    }
-    
-    bool remove_order(OrderId order_id, Order& removed_order) {
-        for (auto it = orders_.begin(); it != orders_.end(); ++it) {
-            if (it->id == order_id) {
-                removed_order = *it;
-                total_quantity_ -= it->quantity;
-                orders_.erase(it);
-                return true;
-            }
+
+    void add_node(std::vector<OrderNode>& pool, OrderNodeIndex index) {
+        OrderNode& node = pool[index];
+        node.prev = tail_;
+        node.next = kNullOrderNode;
+        if (tail_ != kNullOrderNode) {
+            pool[tail_].next = index;
+        } else {
+            head_ = index;
         }
-        return false;
+        tail_ = index;
+        total_quantity_ += node.order.quantity;
+        order_count_++;
+        node.arrival = fenwick_append(node.order.quantity);
     }
-    
-    bool get_next_order(Order& order) {
-        if (orders_.empty()) {
-            return false;
+
+    // Unlink a node from anywhere in the queue in O(1)
+    void remove_node(std::vector<OrderNode>& pool, OrderNodeIndex index) {
+        OrderNode& node = pool[index];
+        if (node.prev != kNullOrderNode) {
+            pool[node.prev].next = node.next;
+        } else {
+            head_ = node.next;
         }
-        order = orders_.front();
-        return true;
-    }
-    
-    bool consume_order(Qty quantity, Order& consumed_order) {
-        if (orders_.empty()) {
-            return false;
+        if (node.next != kNullOrderNode) {
+            pool[node.next].prev = node.prev;
+        } else {
+            tail_ = node.prev;
         }
-        
-        Order& front_order = orders_.front();
-        if (front_order.quantity <= quantity) {
-            // Consume entire order
-            consumed_order = front_order;
-            total_quantity_ -= front_order.quantity;
-            orders_.pop_front();
-            return true;
+        total_quantity_ -= node.order.quantity;
+        order_count_--;
+        if (order_count_ == 0) {
+            // Empty level: recycle the arrival slots wholesale
+            fenwick_.clear();
+            next_arrival_ = 0;
         } else {
-            // Partial fill
-            consumed_order = front_order;
-            consumed_order.quantity = quantity;
-            front_order.quantity -= quantity;
-            total_quantity_ -= quantity;
-            return false; // Order not fully consumed
+            fenwick_update(node.arrival, -node.order.quantity);
         }
     }
-    
+
+    // Reduce an order's quantity after a partial fill
+    void reduce_node_quantity(std::vector<OrderNode>& pool, OrderNodeIndex index, Qty quantity) {
+        pool[index].order.quantity -= quantity;
+        total_quantity_ -= quantity;
+        fenwick_update(pool[index].arrival, -quantity);
+    }
+
+    // Resting quantity ahead of the given arrival slot in FIFO order
+    Qty quantity_ahead(uint32_t arrival) const { return fenwick_prefix(arrival - 1); }
+
+    OrderNodeIndex front() const { return head_; }
     Qty total_quantity() const { return total_quantity_; }
-    size_t order_count() const { return orders_.size(); }
-    bool empty() const { return orders_.empty(); }
-    
-    // Get all orders for debugging
-    const std::deque<Order>& get_orders() const { return orders_; }
+    size_t order_count() const { return order_count_; }
+    bool empty() const { return head_ == kNullOrderNode; }
 
 private:
-    std::deque<Order> orders_;
+    OrderNodeIndex head_ = kNullOrderNode;
+    OrderNodeIndex tail_ = kNullOrderNode;
     Qty total_quantity_ = 0;
+    size_t order_count_ = 0;
+
+    // 1-based Fenwick tree; slot i covers the arrival range (i - lowbit(i), i]
+    std::vector<Qty> fenwick_;
+    uint32_t next_arrival_ = 0;
+
+    static uint32_t lowbit(uint32_t x) { return x & (~x + 1); }
+
+    Qty fenwick_prefix(uint32_t pos) const {
+        Qty sum = 0;
+        for (; pos > 0; pos -= lowbit(pos)) {
+            sum += fenwick_[pos];
+        }
+        return sum;
+    }
+
+    void fenwick_update(uint32_t pos, Qty delta) {
+        for (; pos < fenwick_.size(); pos += lowbit(pos)) {
+            fenwick_[pos] += delta;
+        }
+    }
+
+    // Append a new arrival slot in O(log n): the new slot's range sum is
+    // the value plus whatever of its covered range is already recorded
+    uint32_t fenwick_append(Qty value) {
+        uint32_t arrival = ++next_arrival_;
+        if (fenwick_.empty()) {
+            fenwick_.push_back(0);  // Unused slot 0
+        }
+        Qty covered = fenwick_prefix(arrival - 1) - fenwick_prefix(arrival - lowbit(arrival));
+        fenwick_.push_back(covered + value);
+        return arrival;
+    }
+};
+
+// Configuration for the flat array-indexed ladder backend. Levels are a
+// contiguous array indexed by tick offset from the anchor, with occupancy
+// bitmaps for best-level lookup, so book operations become array
+// arithmetic instead of tree walks. Suitable for instruments trading in
+// a narrow band around a known reference price; limit orders priced
+// outside [anchor - half_width, anchor + half_width] are rejected.
+struct LadderConfig {
+    Price anchor_price = 10000;  // Center of the tick band
+    Price half_width = 500;      // Band extends this many ticks each side
+};
+
+// Admission and expiry limits keeping the book bounded over long runs.
+// Far-from-mid limit orders never trade but still inflate the level
+// structures; these policies reject or expire them so the book stays
+// cache-resident regardless of run length. Zero disables each limit.
+struct AdmissionConfig {
+    Price max_distance_from_mid = 0;  // Reject resting orders farther than this from the mid
+    size_t max_orders_per_side = 0;   // Reject resting orders once a side holds this many
+    Timestamp order_ttl = 0;          // Expire resting orders older than this during matching
 };
 
 // Central Limit Order Book
 class OrderBook {
 public:
+    // Default backend: red-black tree price levels (unbounded price range)
     OrderBook() = default;
-    
-    // Add a limit order to the book
+
+    // Ladder backend: contiguous levels indexed by tick offset
+    explicit OrderBook(const LadderConfig& ladder_config);
+
+    // Pre-size the node pool and order lookup for an expected number of
+    // resting orders, avoiding pool growth in the hot path
+    void reserve(size_t n_orders);
+
+    // Add a limit order to the book. Crossing orders execute immediately
+    // against the opposite side; any remainder rests in the book.
     bool add_limit_order(const Order& order);
-    
+
+    // Same as above, but reports the trades generated by a crossing order.
+    // Makers whose IDs are in excluded_makers are skipped during matching
+    // (self-trade prevention); their orders stay resting untouched.
+    bool add_limit_order(const Order& order, TradeList& trades,
+                         const std::unordered_set<OrderId>* excluded_makers = nullptr);
+
     // Add a market order (immediately match against book)
-    std::vector<Trade> add_market_order(Side side, Qty quantity, OrderId taker_id, Timestamp timestamp);
-    
-    // Cancel an order
+    TradeList add_market_order(Side side, Qty quantity, OrderId taker_id, Timestamp timestamp,
+                               const std::unordered_set<OrderId>* excluded_makers = nullptr);
+
+    // Back trade buffers with an external memory resource (e.g. the
+    // simulation arena) instead of the default heap resource
+    void set_memory_resource(std::pmr::memory_resource* memory) { trade_memory_ = memory; }
+
+    // Cancel an order in O(1) via the node lookup
     bool cancel_order(OrderId order_id);
-    
+
     // Get best bid price and quantity
     std::optional<Price> best_bid_price() const;
     std::optional<Qty> best_bid_quantity() const;
-    
+
     // Get best ask price and quantity
     std::optional<Price> best_ask_price() const;
     std::optional<Qty> best_ask_quantity() const;
-    
+
     // Get top of book (best bid and ask)
     MarketSnapshot top_of_book(Timestamp timestamp) const;
-    
+
     // Get depth snapshot for N levels
     std::vector<PriceLevel> get_depth(int levels = 10) const;
-    
+
+    // Number of levels kept in the incremental depth cache
+    static constexpr int kDepthCacheLevels = 10;
+
+    // Top-of-cache depth views. The cache is refreshed at most once per
+    // book mutation and the spans point into fixed-size arrays, so
+    // repeated snapshot collection on an unchanged book is copy-only.
+    std::span<const PriceLevel> bid_depth() const;
+    std::span<const PriceLevel> ask_depth() const;
+
+    // Monotonic counter bumped on every mutation (add/fill/cancel/clear).
+    // Collectors can compare versions to skip recording unchanged books.
+    uint64_t version() const { return version_; }
+
     // Get total number of orders in book
     size_t size() const { return order_count_; }
-    
+
     // Check if book is empty
-    bool empty() const { return buy_levels_.empty() && sell_levels_.empty(); }
-    
+    bool empty() const { return order_count_ == 0; }
+
+    // Whether the ladder backend is active
+    bool uses_ladder() const { return ladder_enabled_; }
+
+    // Install admission/eviction limits (see AdmissionConfig). Band and
+    // cap checks apply when an order would rest; TTL expiry is processed
+    // lazily as matching walks the queues.
+    void set_admission_config(const AdmissionConfig& config) { admission_ = config; }
+    const AdmissionConfig& admission_config() const { return admission_; }
+
+    // Admission counters
+    size_t rejected_band_count() const { return rejected_band_count_; }
+    size_t rejected_cap_count() const { return rejected_cap_count_; }
+    size_t expired_count() const { return expired_count_; }
+
+    // Orders removed by TTL expiry since the last drain. The engine
+    // drains this after each matching call to release its agent index.
+    const std::vector<OrderId>& expired_order_ids() const { return expired_order_ids_; }
+    void clear_expired_order_ids() { expired_order_ids_.clear(); }
+
+    // Quantity resting ahead of the order in FIFO priority at its price
+    // level, or nullopt if the order is not resting. O(log level size)
+    // via the per-level Fenwick tree, which is maintained incrementally
+    // on adds, fills and cancels — no queue walk per query.
+    std::optional<Qty> queue_position(OrderId order_id) const;
+
+    // Signed imbalance in [-1, 1] of the resting quantity bracketing
+    // `price`: the best bid level at or below it against the best ask
+    // level at or above it, (bid - ask) / (bid + ask). At the mid this is
+    // the usual top-of-book imbalance; at an agent's own quote price it
+    // weighs the support under the quote against the pressure above it.
+    // Returns 0 when neither side has a bracketing level.
+    double level_imbalance(Price price) const;
+
     // Get order by ID (for debugging)
     std::optional<Order> get_order(OrderId order_id) const;
-    
+
+    // Serialize the resting orders (best-to-worst, FIFO within each
+    // level) and trade statistics; restore rebuilds the book so queue
+    // priority is preserved exactly
+    void save_state(std::ostream& out) const;
+    bool load_state(std::istream& in);
+
     // Clear the entire book
     void clear();
-    
+
     // Get last trade price
     Price last_trade_price() const { return last_trade_price_; }
-    
+
     // Get total volume traded
     Qty total_volume() const { return total_volume_; }
-    
+
     // Get number of trades
     size_t trade_count() const { return trade_count_; }
 
 private:
-    // Price level maps (buy: descending, sell: ascending)
+    // Price level maps (buy: descending, sell: ascending) — default backend
     std::map<Price, OrderBookPriceLevel, std::greater<Price>> buy_levels_;
     std::map<Price, OrderBookPriceLevel> sell_levels_;
-    
-    // Order lookup for cancellations
-    std::unordered_map<OrderId, std::pair<Price, Side>> order_lookup_;
-    
+
+    // Ladder backend state. Level i holds price ladder_low_ + i; occupancy
+    // bitmaps mark non-empty levels for O(words) best-level scans.
+    bool ladder_enabled_ = false;
+    Price ladder_low_ = 0;
+    std::vector<OrderBookPriceLevel> ladder_bid_levels_;
+    std::vector<OrderBookPriceLevel> ladder_ask_levels_;
+    std::vector<uint64_t> bid_occupancy_;
+    std::vector<uint64_t> ask_occupancy_;
+
+    // Shared node pool with free-list recycling
+    std::vector<OrderNode> node_pool_;
+    std::vector<OrderNodeIndex> free_nodes_;
+
+    // Order lookup mapping directly to the pool node, for O(1) cancels
+    std::unordered_map<OrderId, OrderNodeIndex> order_lookup_;
+
+    // Memory resource for trade buffers returned by value
+    std::pmr::memory_resource* trade_memory_ = std::pmr::get_default_resource();
+
+    // Depth cache: rebuilt lazily on first access after a mutation,
+    // served straight from the arrays afterwards
+    mutable uint64_t version_ = 1;
+    mutable uint64_t cache_version_ = 0;
+    mutable std::array<PriceLevel, kDepthCacheLevels> bid_cache_{};
+    mutable std::array<PriceLevel, kDepthCacheLevels> ask_cache_{};
+    mutable int bid_cache_count_ = 0;
+    mutable int ask_cache_count_ = 0;
+
+    void refresh_depth_cache() const;
+
     // Statistics
     size_t order_count_ = 0;
     Price last_trade_price_ = 0;
     Qty total_volume_ = 0;
     size_t trade_count_ = 0;
-    
+
+    // Admission/eviction policy state
+    AdmissionConfig admission_;
+    size_t bid_order_count_ = 0;
+    size_t ask_order_count_ = 0;
+    size_t rejected_band_count_ = 0;
+    size_t rejected_cap_count_ = 0;
+    size_t expired_count_ = 0;
+    std::vector<OrderId> expired_order_ids_;
+
+    // Whether a remainder may rest, per the band and per-side caps
+    bool admit_resting_order(const Order& order);
+
+    // Remove a TTL-expired maker from its level and record it
+    void expire_node(OrderBookPriceLevel& level, OrderNodeIndex index);
+
+    // Node pool management
+    OrderNodeIndex allocate_node(const Order& order);
+    void free_node(OrderNodeIndex index);
+
+    // Level holding resting orders for (side, price), or nullptr
+    const OrderBookPriceLevel* find_level(Side side, Price price) const;
+
+    // Ladder helpers
+    bool in_ladder_range(Price price) const {
+        return price >= ladder_low_ &&
+               price < ladder_low_ + static_cast<Price>(ladder_bid_levels_.size());
+    }
+    size_t ladder_index(Price price) const { return static_cast<size_t>(price - ladder_low_); }
+    void set_occupancy(std::vector<uint64_t>& bitmap, size_t index) {
+        bitmap[index >> 6] |= (uint64_t{1} << (index & 63));
+    }
+    void clear_occupancy(std::vector<uint64_t>& bitmap, size_t index) {
+        bitmap[index >> 6] &= ~(uint64_t{1} << (index & 63));
+    }
+    // Returns the lowest/highest occupied ladder index, or -1 if none.
+    // The bounded overloads only consider indices at or above/below the
+    // given start, so matching can resume past a skipped level.
+    long lowest_occupied(const std::vector<uint64_t>& bitmap) const;
+    long lowest_occupied(const std::vector<uint64_t>& bitmap, size_t from) const;
+    long highest_occupied(const std::vector<uint64_t>& bitmap) const;
+    long highest_occupied(const std::vector<uint64_t>& bitmap, size_t from) const;
+
+    // Consume a level in FIFO order until it empties or the taker is
+    // filled, skipping excluded makers; shared by both backends. Returns
+    // true if the level emptied.
+    bool consume_level(OrderBookPriceLevel& level, Price price, OrderId taker_id,
+                       Timestamp timestamp, TradeList& trades, Qty& remaining_qty,
+                       const std::unordered_set<OrderId>* excluded_makers);
+
     // Helper methods
     bool add_limit_order_to_side(const Order& order);
-    std::vector<Trade> match_market_order_buy(Qty quantity, OrderId taker_id, Timestamp timestamp);
-    std::vector<Trade> match_market_order_sell(Qty quantity, OrderId taker_id, Timestamp timestamp);
-    void remove_order_from_side(OrderId order_id, Price price, Side side);
+    void match_against_asks(Qty quantity, Price price_limit, OrderId taker_id,
+                            Timestamp timestamp, TradeList& trades, Qty& remaining_qty,
+                            const std::unordered_set<OrderId>* excluded_makers);
+    void match_against_bids(Qty quantity, Price price_limit, OrderId taker_id,
+                            Timestamp timestamp, TradeList& trades, Qty& remaining_qty,
+                            const std::unordered_set<OrderId>* excluded_makers);
 };
 
 } // namespace mms
@@ -1,74 +1,178 @@
 #pragma once
 
-#include <random>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
 
 namespace mms {
 
-// Seeded random number generator for reproducible simulations
+// Seeded random number generator for reproducible simulations.
+//
+// The core is xoshiro256++ (Blackman/Vigna): four words of state, a
+// handful of shifts and rotates per draw, and no per-call distribution
+// objects. Samplers are inlined on top of the raw 64-bit stream —
+// Lemire's multiply-and-reject for bounded integers, a bit-shift scale
+// for unit doubles, inverse-CDF for exponential/geometric and a cached
+// Box-Muller pair for normals — so the hot agent paths draw variates
+// without touching <random> machinery. The class also satisfies
+// UniformRandomBitGenerator, so it plugs into std::shuffle directly.
 class RNG {
 public:
-    explicit RNG(uint64_t seed = 0) : gen_(seed) {}
-    
+    explicit RNG(uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    // UniformRandomBitGenerator interface
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()() { return next_u64(); }
+
     // Generate uniform random integer in [min, max]
     template<typename T>
     T uniform_int(T min, T max) {
-        std::uniform_int_distribution<T> dist(min, max);
-        return dist(gen_);
+        uint64_t span = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+        if (span == UINT64_MAX) {
+            return static_cast<T>(next_u64());
+        }
+        return static_cast<T>(static_cast<uint64_t>(min) + bounded(span + 1));
     }
-    
+
     // Generate uniform random float in [0, 1)
     double uniform_real() {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        return dist(gen_);
+        // 53 high bits scaled into the unit interval
+        return static_cast<double>(next_u64() >> 11) * 0x1.0p-53;
     }
-    
+
     // Generate uniform random float in [min, max)
     double uniform_real(double min, double max) {
-        std::uniform_real_distribution<double> dist(min, max);
-        return dist(gen_);
+        return min + uniform_real() * (max - min);
     }
-    
+
     // Generate exponential random variable (for Poisson processes)
     double exponential(double lambda) {
-        std::exponential_distribution<double> dist(lambda);
-        return dist(gen_);
+        // Inverse CDF; log1p keeps precision when the uniform is tiny
+        return -std::log1p(-uniform_real()) / lambda;
     }
-    
+
     // Generate normal random variable
     double normal(double mean, double stddev) {
-        std::normal_distribution<double> dist(mean, stddev);
-        return dist(gen_);
+        // Box-Muller produces variates in pairs; keep the spare so every
+        // second call is just a multiply-add
+        if (has_spare_normal_) {
+            has_spare_normal_ = false;
+            return mean + stddev * spare_normal_;
+        }
+        double u1, u2;
+        do {
+            u1 = uniform_real();
+        } while (u1 <= 0.0);
+        u2 = uniform_real();
+        double radius = std::sqrt(-2.0 * std::log(u1));
+        double angle = 2.0 * 3.141592653589793238462643 * u2;
+        spare_normal_ = radius * std::sin(angle);
+        has_spare_normal_ = true;
+        return mean + stddev * radius * std::cos(angle);
     }
-    
+
     // Generate Poisson random variable
     int poisson(double lambda) {
-        std::poisson_distribution<int> dist(lambda);
-        return dist(gen_);
+        if (lambda > 30.0) {
+            // Normal approximation for large rates
+            double value = std::round(normal(lambda, std::sqrt(lambda)));
+            return value > 0.0 ? static_cast<int>(value) : 0;
+        }
+        // Knuth's product-of-uniforms method
+        double threshold = std::exp(-lambda);
+        double product = uniform_real();
+        int count = 0;
+        while (product > threshold) {
+            product *= uniform_real();
+            count++;
+        }
+        return count;
     }
-    
+
     // Generate geometric random variable (for discrete events)
     int geometric(double p) {
-        std::geometric_distribution<int> dist(p);
-        return dist(gen_);
+        if (p >= 1.0) {
+            return 0;
+        }
+        double u;
+        do {
+            u = uniform_real();
+        } while (u <= 0.0);
+        return static_cast<int>(std::log(u) / std::log1p(-p));
     }
-    
+
     // Reset with new seed
     void seed(uint64_t new_seed) {
-        gen_.seed(new_seed);
+        seed_ = new_seed;
+        // Expand the seed through splitmix64 so nearby seeds produce
+        // fully decorrelated initial states
+        uint64_t x = new_seed;
+        for (auto& word : state_) {
+            word = splitmix64(x);
+        }
+        has_spare_normal_ = false;
+        spare_normal_ = 0.0;
     }
-    
+
     // Get current seed (for debugging)
     uint64_t get_seed() const {
-        return gen_.default_seed;
+        return seed_;
     }
-    
+
+    // Derive an independent stream from this one. The child is seeded
+    // from this generator's output mixed with the splitmix64 constant,
+    // so parallel workers can each take a split of one master RNG
+    // without sharing or correlating their sequences.
+    RNG split() {
+        return RNG(next_u64() ^ 0x9E3779B97F4A7C15ULL);
+    }
+
+    // Fixed per-stream generator for a stream ID (e.g. an agent ID).
+    // Unlike split(), this derives from the seed alone and does not
+    // advance the parent, so a stream depends only on (master seed,
+    // stream ID) — the same stream comes back no matter how much the
+    // master has been used or in what order streams are created.
+    RNG stream(uint64_t stream_id) const {
+        uint64_t x = seed_ ^ (stream_id + 0x9E3779B97F4A7C15ULL);
+        return RNG(splitmix64(x));
+    }
+
+    // Snapshot of the full generator state, including the cached
+    // Box-Muller variate, so a restored stream resumes bit-exact
+    struct State {
+        uint64_t state[4];
+        uint64_t seed;
+        double spare_normal;
+        bool has_spare_normal;
+    };
+
+    State get_state() const {
+        State snapshot;
+        std::copy(std::begin(state_), std::end(state_), std::begin(snapshot.state));
+        snapshot.seed = seed_;
+        snapshot.spare_normal = spare_normal_;
+        snapshot.has_spare_normal = has_spare_normal_;
+        return snapshot;
+    }
+
+    void set_state(const State& snapshot) {
+        std::copy(std::begin(snapshot.state), std::end(snapshot.state), std::begin(state_));
+        seed_ = snapshot.seed;
+        spare_normal_ = snapshot.spare_normal;
+        has_spare_normal_ = snapshot.has_spare_normal;
+    }
+
     // Generate random boolean
     bool bernoulli(double p = 0.5) {
-        std::bernoulli_distribution dist(p);
-        return dist(gen_);
+        return uniform_real() < p;
     }
-    
+
     // Choose random element from container
     template<typename Container>
     auto choose(const Container& container) -> decltype(*container.begin()) {
@@ -79,15 +183,60 @@ public:
         std::advance(it, uniform_int<size_t>(0, container.size() - 1));
         return *it;
     }
-    
+
     // Shuffle container in place
     template<typename Container>
     void shuffle(Container& container) {
-        std::shuffle(container.begin(), container.end(), gen_);
+        std::shuffle(container.begin(), container.end(), *this);
     }
 
 private:
-    std::mt19937_64 gen_;
+    uint64_t state_[4] = {};
+    uint64_t seed_ = 0;
+
+    // Cached second Box-Muller variate
+    double spare_normal_ = 0.0;
+    bool has_spare_normal_ = false;
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // xoshiro256++ core step
+    uint64_t next_u64() {
+        uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+        uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    // Lemire's multiply-and-reject bounded integer in [0, range)
+    uint64_t bounded(uint64_t range) {
+        uint64_t x = next_u64();
+        __uint128_t m = static_cast<__uint128_t>(x) * range;
+        uint64_t low = static_cast<uint64_t>(m);
+        if (low < range) {
+            uint64_t threshold = (0 - range) % range;
+            while (low < threshold) {
+                x = next_u64();
+                m = static_cast<__uint128_t>(x) * range;
+                low = static_cast<uint64_t>(m);
+            }
+        }
+        return static_cast<uint64_t>(m >> 64);
+    }
 };
 
 // Utility function to generate seed from current time
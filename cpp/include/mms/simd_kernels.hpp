@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mms {
+namespace analysis {
+// Wide-register reduction kernels for the columnar analysis paths. Each
+// entry point picks an AVX2 implementation at runtime when the CPU
+// supports it and falls back to a scalar loop otherwise, so callers
+// never need to know the ISA. Integer kernels convert lanes to double
+// and assume |value| < 2^51 (comfortably true for prices, quantities
+// and spreads), which keeps the conversion to two vector ops on AVX2.
+namespace simd {
+
+struct MinMax {
+    int64_t min = 0;
+    int64_t max = 0;
+};
+
+// Population mean and variance computed in a single pass
+struct MeanVariance {
+    double mean = 0.0;
+    double variance = 0.0;
+};
+
+// Sum of a column, returned as double
+double sum(const double* values, size_t n);
+double sum(const int64_t* values, size_t n);
+
+// Elementwise product sum (e.g. price * quantity for VWAP)
+double dot(const int64_t* a, const int64_t* b, size_t n);
+
+// Minimum and maximum in one pass; n must be > 0
+MinMax min_max(const int64_t* values, size_t n);
+
+// Mean and population variance in one pass; n must be > 0
+MeanVariance mean_variance(const double* values, size_t n);
+MeanVariance mean_variance(const int64_t* values, size_t n);
+
+// Whether the AVX2 paths are active on this machine (for diagnostics)
+bool avx2_enabled();
+
+} // namespace simd
+} // namespace analysis
+} // namespace mms
@@ -3,10 +3,14 @@
 #include "types.hpp"
 #include "matching_engine.hpp"
 #include "agents.hpp"
+#include "arena.hpp"
+#include "network.hpp"
 #include "rng.hpp"
+#include <array>
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <fstream>
 
 namespace mms {
@@ -19,6 +23,115 @@ struct SimulationConfig {
     size_t max_steps = 1000000;            // Maximum simulation steps
     bool enable_logging = false;           // Enable detailed logging
     std::string output_dir = "output";     // Output directory for results
+    bool binary_output = false;            // Write columnar binary instead of CSV
+    bool event_driven = false;             // Jump between agent wakeups instead of polling every step
+    bool pipelined = false;                // Run matching on a worker thread fed by SPSC rings
+    bool self_trade_prevention = false;    // Skip matching orders against the same agent's quotes
+    bool aggregate_only = false;           // Keep online aggregates + reservoirs instead of raw rows
+    size_t reservoir_rows = 10000;         // Reservoir sample size in aggregate-only mode
+    AdmissionConfig admission;             // Book admission/eviction limits (zeros disable)
+    size_t agent_threads = 1;              // >1 steps agents in parallel (deterministic merge)
+    MemoryConfig memory;                   // Huge-page backing and worker placement
+    NetworkConfig network;                 // Agent-to-exchange delay model (see network.hpp)
+};
+
+// Constant-memory run summary maintained online while trades and
+// snapshots stream through the collector: counting accumulators for
+// VWAP and volume, Welford mean/variance of snapshot-to-snapshot log
+// returns for volatility, and a fixed tick histogram of spreads for
+// quantiles. Everything is updated in O(1) per observation, so the
+// final-stats path needs no second pass over raw data.
+struct StreamingAggregates {
+    // Trades
+    uint64_t trade_count = 0;
+    Qty total_volume = 0;
+    double price_volume_sum = 0.0;   // sum(price * quantity)
+    double volume_sum = 0.0;         // sum(quantity)
+
+    // Snapshots (log returns via Welford, spreads via tick histogram)
+    uint64_t snapshot_count = 0;
+    Price prev_last_trade = 0;
+    uint64_t return_count = 0;
+    double return_mean = 0.0;
+    double return_m2 = 0.0;
+    double spread_sum = 0.0;
+    Price spread_min = 0;
+    Price spread_max = 0;
+    uint64_t spread_count = 0;
+
+    // Spread histogram: one bucket per tick plus an overflow bucket
+    static constexpr size_t kSpreadBuckets = 1024;
+    std::array<uint64_t, kSpreadBuckets + 1> spread_histogram{};
+
+    double vwap() const { return volume_sum > 0.0 ? price_volume_sum / volume_sum : 0.0; }
+    double price_volatility() const;
+    double average_spread() const {
+        return spread_count > 0 ? spread_sum / static_cast<double>(spread_count) : 0.0;
+    }
+
+    // Spread value at the given quantile (fraction in [0, 1]), exact to
+    // one tick within the histogram range
+    Price spread_quantile(double fraction) const;
+
+    void add_trade(const Trade& trade);
+    void add_snapshot(const MarketSnapshot& snapshot);
+    void clear();
+};
+
+// Structure-of-arrays storage for collected data: one contiguous vector
+// per field, so analysis passes touch only the columns they need and the
+// compiler can vectorize the reductions. Columns grow in fixed-size
+// chunks instead of capacity doubling, which caps the transient memory
+// spike of a grow at one chunk rather than the whole table.
+inline constexpr size_t kColumnChunkRows = 65536;
+
+struct TradeColumns {
+    std::vector<Timestamp> timestamp;
+    std::vector<OrderId> maker_id;
+    std::vector<OrderId> taker_id;
+    std::vector<Price> price;
+    std::vector<Qty> quantity;
+
+    size_t size() const { return timestamp.size(); }
+    bool empty() const { return timestamp.empty(); }
+    void clear();
+    void reserve(size_t n);
+    void push_back(const Trade& trade);
+    Trade row(size_t i) const {
+        return Trade(maker_id[i], taker_id[i], price[i], quantity[i], timestamp[i]);
+    }
+};
+
+struct SnapshotColumns {
+    std::vector<Timestamp> timestamp;
+    std::vector<Price> best_bid;
+    std::vector<Price> best_ask;
+    std::vector<Qty> best_bid_qty;
+    std::vector<Qty> best_ask_qty;
+    std::vector<Price> last_trade_price;
+
+    size_t size() const { return timestamp.size(); }
+    bool empty() const { return timestamp.empty(); }
+    void clear();
+    void reserve(size_t n);
+    void push_back(const MarketSnapshot& snapshot);
+    MarketSnapshot row(size_t i) const {
+        return MarketSnapshot(best_bid[i], best_ask[i], best_bid_qty[i], best_ask_qty[i],
+                              last_trade_price[i], timestamp[i]);
+    }
+};
+
+struct AgentPnlColumns {
+    std::vector<OrderId> agent_id;
+    std::vector<Timestamp> timestamp;
+    std::vector<double> pnl;
+    std::vector<Qty> inventory;
+
+    size_t size() const { return agent_id.size(); }
+    bool empty() const { return agent_id.empty(); }
+    void clear();
+    void reserve(size_t n);
+    void push_back(OrderId id, Timestamp time, double value, Qty position);
 };
 
 // Market data collector for simulation results
@@ -35,10 +148,15 @@ public:
     // Record agent PnL
     void record_agent_pnl(OrderId agent_id, Timestamp timestamp, double pnl, Qty inventory);
     
-    // Get collected data
-    const std::vector<Trade>& get_trades() const { return trades_; }
-    const std::vector<MarketSnapshot>& get_snapshots() const { return snapshots_; }
-    const std::vector<std::tuple<OrderId, Timestamp, double, Qty>>& get_agent_pnl() const { return agent_pnl_; }
+    // Direct column views (no copies)
+    const TradeColumns& trade_columns() const { return trades_; }
+    const SnapshotColumns& snapshot_columns() const { return snapshots_; }
+    const AgentPnlColumns& agent_pnl_columns() const { return agent_pnl_; }
+    
+    // Materialized row-wise copies, for callers that want AoS data
+    std::vector<Trade> get_trades() const;
+    std::vector<MarketSnapshot> get_snapshots() const;
+    std::vector<std::tuple<OrderId, Timestamp, double, Qty>> get_agent_pnl() const;
     
     // Clear all data
     void clear();
@@ -46,10 +164,60 @@ public:
     // Save data to CSV files
     void save_to_csv(const std::string& output_dir) const;
 
+    // Save data to binary columnar files (one 64-bit little-endian column
+    // per field, blocked; see docs in simulator.cpp and the Python reader
+    // in python/mms/utils.py)
+    void save_to_binary(const std::string& output_dir) const;
+
+    // Streaming mode: flush fixed-size blocks to the binary files during
+    // the run instead of buffering everything in memory. Buffers are
+    // reused as the current block, so memory stays bounded by block_rows.
+    void enable_streaming(const std::string& output_dir, size_t block_rows = 65536);
+
+    // Flush any partial blocks and close the streaming files
+    void finish_streaming();
+
+    bool streaming() const { return streaming_; }
+
+    // Aggregate-only mode: per-row storage is replaced by the online
+    // StreamingAggregates plus fixed-size reservoir samples, so memory
+    // stays constant regardless of run length. The seed makes reservoir
+    // sampling reproducible for a given run configuration.
+    void enable_aggregation(size_t reservoir_rows, uint64_t seed);
+
+    bool aggregating() const { return aggregating_; }
+    const StreamingAggregates& aggregates() const { return aggregates_; }
+
+    // Reservoir samples collected in aggregate-only mode
+    const std::vector<Trade>& trade_reservoir() const { return trade_reservoir_; }
+    const std::vector<MarketSnapshot>& snapshot_reservoir() const { return snapshot_reservoir_; }
+
+    ~MarketDataCollector();
+
 private:
-    std::vector<Trade> trades_;
-    std::vector<MarketSnapshot> snapshots_;
-    std::vector<std::tuple<OrderId, Timestamp, double, Qty>> agent_pnl_; // agent_id, timestamp, pnl, inventory
+    TradeColumns trades_;
+    SnapshotColumns snapshots_;
+    AgentPnlColumns agent_pnl_;
+
+    // Aggregation state
+    bool aggregating_ = false;
+    size_t reservoir_rows_ = 0;
+    StreamingAggregates aggregates_;
+    std::vector<Trade> trade_reservoir_;
+    std::vector<MarketSnapshot> snapshot_reservoir_;
+    std::unordered_map<OrderId, size_t> agent_pnl_slots_; // agent ID -> row kept per agent
+    RNG reservoir_rng_;
+
+    // Streaming state
+    bool streaming_ = false;
+    size_t block_rows_ = 0;
+    std::ofstream trades_stream_;
+    std::ofstream snapshots_stream_;
+    std::ofstream agent_pnl_stream_;
+
+    void flush_trades_block();
+    void flush_snapshots_block();
+    void flush_agent_pnl_block();
 };
 
 // Main simulation orchestrator
@@ -66,6 +234,18 @@ public:
         size_t total_trades;
         Timestamp simulation_duration;
         double simulation_time_seconds;
+
+        // Hot-path latency percentiles per timing site; empty unless
+        // built with MMS_ENABLE_INSTRUMENTATION
+        std::vector<instrumentation::LatencyStats> latency_report;
+
+        // Online run summary. Always populated; in aggregate-only mode
+        // the raw vectors above hold reservoir samples instead of every
+        // row, and this carries the exact totals.
+        StreamingAggregates aggregates;
+
+        // Memory placement of this run (arena backing, executing CPU)
+        MemoryStats memory_stats;
     };
     
     RunResult run(
@@ -77,11 +257,28 @@ public:
     
     // Run simulation with custom agents
     RunResult run_with_agents(size_t n_steps, std::vector<std::unique_ptr<Agent>> agents);
+
+    // Continue the current simulation for n_steps more without resetting
+    // state; pairs with restore_checkpoint for incremental long runs
+    RunResult resume(size_t n_steps);
+
+    // Binary checkpoint of the full simulation state: book, per-agent
+    // state, RNG stream position and simulation clock. restore_checkpoint
+    // requires the same agent lineup to be registered (e.g. after a run
+    // with the same configs) and resumes bit-exact.
+    bool save_checkpoint(const std::string& path) const;
+    bool restore_checkpoint(const std::string& path);
+
+    // Stream variants of the above, for forking state in memory (see
+    // differential.hpp) without touching disk
+    bool save_checkpoint(std::ostream& out) const;
+    bool restore_checkpoint(std::istream& in);
     
     // Get current simulation state
     const MatchingEngine& get_matching_engine() const { return matching_engine_; }
     const AgentManager& get_agent_manager() const { return agent_manager_; }
     const MarketDataCollector& get_data_collector() const { return data_collector_; }
+    MarketDataCollector& get_data_collector() { return data_collector_; }
     
     // Get simulation statistics
     struct SimulationStats {
@@ -94,9 +291,19 @@ public:
         double price_volatility;
         Timestamp simulation_duration;
         double events_per_second;
+        size_t orders_rejected_band;
+        size_t orders_rejected_cap;
+        size_t orders_expired;
     };
     
     SimulationStats get_stats() const;
+
+    // Latency histogram summaries from the engine's matching paths and
+    // agent stepping (p50/p99/p999 per event type)
+    std::vector<instrumentation::LatencyStats> get_latency_report() const;
+
+    // Current memory placement: arena backing and the calling CPU
+    MemoryStats get_memory_stats() const;
     
     // Reset simulation state
     void reset();
@@ -113,9 +320,14 @@ public:
 private:
     SimulationConfig config_;
     RNG rng_;
+    Arena arena_;
     MatchingEngine matching_engine_;
     AgentManager agent_manager_;
     MarketDataCollector data_collector_;
+
+    // Agent-to-exchange delay model and the events in flight under it
+    NetworkModel network_;
+    PendingEventQueue pending_events_;
     
     bool data_collection_enabled_ = true;
     
@@ -123,6 +335,7 @@ private:
     Timestamp current_time_;
     size_t current_step_;
     size_t events_processed_;
+    uint64_t last_collected_book_version_ = 0; // Skip snapshots of an unchanged book
     
     // Helper methods
     void initialize_agents(
@@ -131,7 +344,14 @@ private:
         const NoiseTrader::Config& noise_config
     );
     
+    void advance_simulation(size_t n_steps);
     void process_simulation_step();
+    void run_pipelined_loop(size_t n_steps);
+    void run_event_loop(Timestamp end_time);
+    void process_agent_wakeup(Agent& agent);
+
+    // Match every in-flight event due at or before `up_to`
+    void deliver_network_events(Timestamp up_to);
     void collect_market_data();
     void collect_agent_data();
     
@@ -145,12 +365,15 @@ namespace analysis {
     
     // Calculate volume-weighted average price (VWAP)
     double calculate_vwap(const std::vector<Trade>& trades);
+    double calculate_vwap(const TradeColumns& trades);
     
     // Calculate time-weighted average price (TWAP)
     double calculate_twap(const std::vector<MarketSnapshot>& snapshots);
+    double calculate_twap(const SnapshotColumns& snapshots);
     
     // Calculate realized volatility
     double calculate_realized_volatility(const std::vector<MarketSnapshot>& snapshots);
+    double calculate_realized_volatility(const SnapshotColumns& snapshots);
     
     // Calculate bid-ask spread statistics
     struct SpreadStats {
@@ -162,6 +385,7 @@ namespace analysis {
     };
     
     SpreadStats calculate_spread_stats(const std::vector<MarketSnapshot>& snapshots);
+    SpreadStats calculate_spread_stats(const SnapshotColumns& snapshots);
     
     // Calculate agent performance metrics
     struct AgentPerformance {
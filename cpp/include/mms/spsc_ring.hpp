@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace mms {
+
+// Fixed-capacity lock-free single-producer/single-consumer ring buffer.
+// Exactly one thread may call try_push and one other thread try_pop;
+// under that contract the ring is wait-free. Indices grow monotonically
+// and are masked into the buffer, so capacity is rounded up to a power
+// of two. Each side caches the other side's index and only re-reads the
+// shared atomic when the cache says the ring looks full/empty, which
+// keeps the common case free of cross-core traffic.
+template <typename T>
+class SPSCRing {
+public:
+    explicit SPSCRing(size_t capacity) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        buffer_.resize(rounded);
+        mask_ = rounded - 1;
+    }
+
+    // Producer side: returns false if the ring is full
+    bool try_push(const T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ > mask_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ > mask_) {
+                return false;
+            }
+        }
+        buffer_[head & mask_] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: returns false if the ring is empty
+    bool try_pop(T& out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) {
+                return false;
+            }
+        }
+        out = buffer_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Approximate when called concurrently; exact when the other side is idle
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    std::vector<T> buffer_;
+    size_t mask_ = 0;
+
+    // Producer and consumer indices live on their own cache lines to
+    // avoid false sharing, as do the per-side caches of the remote index
+    alignas(64) std::atomic<size_t> head_{0}; // Written by producer
+    alignas(64) std::atomic<size_t> tail_{0}; // Written by consumer
+    alignas(64) size_t head_cache_ = 0;       // Consumer's cache of head_
+    alignas(64) size_t tail_cache_ = 0;       // Producer's cache of tail_
+};
+
+} // namespace mms
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "simulator.hpp"
+#include <vector>
+
+namespace mms {
+
+// One point of an agent-parameter grid swept by SweepRunner
+struct AgentConfigPoint {
+    MarketMaker::Config maker_config;
+    Taker::Config taker_config;
+    NoiseTrader::Config noise_config;
+};
+
+// Configuration for a parallel seed/parameter sweep. Every (grid point,
+// seed) pair becomes one independent job; seeds run from first_seed to
+// first_seed + n_seeds - 1. An empty grid sweeps a single point with
+// default agent configs.
+struct SweepConfig {
+    SimulationConfig base;                 // Per-run simulation config (seed is overridden)
+    uint64_t first_seed = 0;
+    size_t n_seeds = 1;
+    size_t n_threads = 0;                  // 0 = one worker per hardware core
+    std::vector<AgentConfigPoint> grid;    // Agent config grid (empty = defaults)
+};
+
+// Fans simulation runs across a pool of worker threads. Each worker owns
+// its own Simulator (and therefore its own RNG, arena, book and agents)
+// and pulls jobs from a shared atomic ticket, so load balances itself
+// without any locking and no state is shared between runs. Results are
+// keyed by job index, making the output independent of worker count.
+class SweepRunner {
+public:
+    explicit SweepRunner(const SweepConfig& config);
+
+    // Per-run summary; bulky per-run data (trade vectors, snapshots) is
+    // deliberately reduced to scalars so 10k-seed sweeps stay cheap
+    struct RunSummary {
+        uint64_t seed = 0;
+        size_t config_index = 0;           // Index into SweepConfig::grid
+        size_t total_events_processed = 0;
+        size_t total_trades = 0;
+        double vwap = 0.0;
+        double simulation_time_seconds = 0.0;
+    };
+
+    struct SweepResult {
+        std::vector<RunSummary> runs;      // Ordered by (config_index, seed)
+        size_t total_events_processed = 0;
+        size_t total_trades = 0;
+        double mean_trades_per_run = 0.0;
+        double std_trades_per_run = 0.0;
+        double mean_events_per_run = 0.0;
+        double std_events_per_run = 0.0;
+        double wall_time_seconds = 0.0;
+    };
+
+    SweepResult run(size_t n_steps);
+
+    size_t n_jobs() const;
+    size_t n_workers() const { return n_workers_; }
+
+private:
+    SweepConfig config_;
+    size_t n_workers_;
+};
+
+} // namespace mms
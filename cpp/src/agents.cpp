@@ -1,12 +1,16 @@
 #include "mms/agents.hpp"
+#include "mms/checkpoint.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
+#include <thread>
 
 namespace mms {
 
 // MarketMaker implementation
 MarketMaker::MarketMaker(OrderId id, const std::string& name, const Config& config, RNG& rng)
-    : Agent(id, name), config_(config), rng_(rng) {
+    : Agent(id, name), config_(config), rng_(rng.stream(id)) {
     reset();
 }
 
@@ -19,8 +23,10 @@ std::vector<Event> MarketMaker::step(Timestamp timestamp) {
         update_quotes(mid_price);
     }
     
-    // Cancel old orders if needed
-    if (timestamp - last_refresh_ >= config_.refresh_interval) {
+    // Refresh quotes when the interval has elapsed, or immediately if we
+    // have no resting quotes (e.g. first step after a reset)
+    bool has_quotes = (bid_order_id_ != 0 || ask_order_id_ != 0);
+    if (!has_quotes || timestamp - last_refresh_ >= config_.refresh_interval) {
         cancel_old_orders(timestamp, events);
         place_new_orders(mid_price, timestamp, events);
         last_refresh_ = timestamp;
@@ -58,6 +64,7 @@ void MarketMaker::on_trade(const Trade& trade) {
 }
 
 void MarketMaker::reset() {
+    rng_.seed(rng_.get_seed()); // Rewind the agent's stream
     inventory_ = 0;
     pnl_ = 0.0;
     last_refresh_ = 0;
@@ -123,9 +130,42 @@ void MarketMaker::place_new_orders(Price mid_price, Timestamp timestamp, std::ve
     }
 }
 
+void MarketMaker::save_state(std::ostream& out) const {
+    checkpoint::write_pod(out, rng_.get_state());
+    checkpoint::write_pod(out, inventory_);
+    checkpoint::write_pod(out, pnl_);
+    checkpoint::write_pod(out, last_refresh_);
+    checkpoint::write_pod(out, current_bid_);
+    checkpoint::write_pod(out, current_ask_);
+    checkpoint::write_pod(out, bid_order_id_);
+    checkpoint::write_pod(out, ask_order_id_);
+}
+
+bool MarketMaker::load_state(std::istream& in) {
+    RNG::State rng_state;
+    if (!checkpoint::read_pod(in, rng_state)) {
+        return false;
+    }
+    rng_.set_state(rng_state);
+    return checkpoint::read_pod(in, inventory_) &&
+           checkpoint::read_pod(in, pnl_) &&
+           checkpoint::read_pod(in, last_refresh_) &&
+           checkpoint::read_pod(in, current_bid_) &&
+           checkpoint::read_pod(in, current_ask_) &&
+           checkpoint::read_pod(in, bid_order_id_) &&
+           checkpoint::read_pod(in, ask_order_id_);
+}
+
+Timestamp MarketMaker::next_event_time(Timestamp current_time) const {
+    // With no resting quotes we want to act immediately; otherwise the
+    // next refresh is due one interval after the last one
+    bool has_quotes = (bid_order_id_ != 0 || ask_order_id_ != 0);
+    return has_quotes ? last_refresh_ + config_.refresh_interval : current_time;
+}
+
 // Taker implementation
 Taker::Taker(OrderId id, const std::string& name, const Config& config, RNG& rng)
-    : Agent(id, name), config_(config), rng_(rng) {
+    : Agent(id, name), config_(config), rng_(rng.stream(id)) {
     reset();
 }
 
@@ -169,6 +209,7 @@ void Taker::on_trade(const Trade& trade) {
 }
 
 void Taker::reset() {
+    rng_.seed(rng_.get_seed());
     inventory_ = 0;
     pnl_ = 0.0;
     next_order_time_ = 0;
@@ -198,9 +239,31 @@ Price Taker::generate_aggressive_price(Side side, Price current_bid, Price curre
     }
 }
 
+Timestamp Taker::next_event_time(Timestamp /*current_time*/) const {
+    return next_order_time_;
+}
+
+void Taker::save_state(std::ostream& out) const {
+    checkpoint::write_pod(out, rng_.get_state());
+    checkpoint::write_pod(out, inventory_);
+    checkpoint::write_pod(out, pnl_);
+    checkpoint::write_pod(out, next_order_time_);
+}
+
+bool Taker::load_state(std::istream& in) {
+    RNG::State rng_state;
+    if (!checkpoint::read_pod(in, rng_state)) {
+        return false;
+    }
+    rng_.set_state(rng_state);
+    return checkpoint::read_pod(in, inventory_) &&
+           checkpoint::read_pod(in, pnl_) &&
+           checkpoint::read_pod(in, next_order_time_);
+}
+
 // NoiseTrader implementation
 NoiseTrader::NoiseTrader(OrderId id, const std::string& name, const Config& config, RNG& rng)
-    : Agent(id, name), config_(config), rng_(rng) {
+    : Agent(id, name), config_(config), rng_(rng.stream(id)) {
     reset();
 }
 
@@ -255,6 +318,7 @@ void NoiseTrader::on_trade(const Trade& trade) {
 }
 
 void NoiseTrader::reset() {
+    rng_.seed(rng_.get_seed());
     inventory_ = 0;
     pnl_ = 0.0;
     next_limit_order_time_ = 0;
@@ -307,6 +371,429 @@ void NoiseTrader::maybe_cancel_random_order(Timestamp timestamp, std::vector<Eve
     }
 }
 
+Timestamp NoiseTrader::next_event_time(Timestamp /*current_time*/) const {
+    return std::min(next_limit_order_time_, next_cancel_time_);
+}
+
+void NoiseTrader::save_state(std::ostream& out) const {
+    checkpoint::write_pod(out, rng_.get_state());
+    checkpoint::write_pod(out, inventory_);
+    checkpoint::write_pod(out, pnl_);
+    checkpoint::write_pod(out, next_limit_order_time_);
+    checkpoint::write_pod(out, next_cancel_time_);
+    checkpoint::write_pod(out, reference_price_);
+    checkpoint::write_pod(out, static_cast<uint64_t>(active_orders_.size()));
+    for (const auto& [order_id, order] : active_orders_) {
+        checkpoint::write_pod(out, order);
+    }
+}
+
+bool NoiseTrader::load_state(std::istream& in) {
+    RNG::State rng_state;
+    if (!checkpoint::read_pod(in, rng_state)) {
+        return false;
+    }
+    rng_.set_state(rng_state);
+    if (!checkpoint::read_pod(in, inventory_) ||
+        !checkpoint::read_pod(in, pnl_) ||
+        !checkpoint::read_pod(in, next_limit_order_time_) ||
+        !checkpoint::read_pod(in, next_cancel_time_) ||
+        !checkpoint::read_pod(in, reference_price_)) {
+        return false;
+    }
+    uint64_t n_orders = 0;
+    if (!checkpoint::read_pod(in, n_orders)) {
+        return false;
+    }
+    active_orders_.clear();
+    for (uint64_t i = 0; i < n_orders; ++i) {
+        Order order;
+        if (!checkpoint::read_pod(in, order)) {
+            return false;
+        }
+        active_orders_[order.id] = order;
+    }
+    return true;
+}
+
+// HawkesTrader implementation
+HawkesTrader::HawkesTrader(OrderId id, const std::string& name, const Config& config, RNG& rng)
+    : Agent(id, name), config_(config), rng_(rng.stream(id)) {
+    reset();
+}
+
+std::vector<Event> HawkesTrader::step(Timestamp timestamp) {
+    std::vector<Event> events;
+
+    // Arm the process on the first step after construction or reset
+    if (next_stream_ < 0 && next_event_time_ == 0) {
+        schedule_next_event(timestamp);
+    }
+
+    if (next_stream_ < 0 || timestamp < next_event_time_) {
+        return events;
+    }
+
+    // Record the arrival in the recursion state: decay R to now, then
+    // apply the unit kernel jump for the stream that fired. Both steps
+    // are O(1) — the decayed state already summarizes all history.
+    decay_excitation_to(timestamp);
+    excitation_[next_stream_] += 1.0;
+
+    if (next_stream_ == CANCEL) {
+        if (!active_orders_.empty()) {
+            auto it = active_orders_.begin();
+            std::advance(it, rng_.uniform_int<size_t>(0, active_orders_.size() - 1));
+            events.emplace_back(EventType::CANCEL, it->first, Side::BUY, 0, 0,
+                                timestamp, get_id());
+            active_orders_.erase(it);
+        }
+    } else {
+        Side side = next_stream_ == BUY ? Side::BUY : Side::SELL;
+        Qty quantity = generate_order_quantity();
+        Price price = generate_limit_price(side, reference_price_);
+        OrderId order_id = timestamp + get_id() + rng_.uniform_int(0, 1000);
+
+        events.emplace_back(EventType::LIMIT, order_id, side, price, quantity,
+                            timestamp, get_id());
+        active_orders_[order_id] = Order(order_id, side, price, quantity, timestamp);
+    }
+
+    schedule_next_event(timestamp);
+    return events;
+}
+
+Timestamp HawkesTrader::next_event_time(Timestamp /*current_time*/) const {
+    return next_event_time_;
+}
+
+void HawkesTrader::on_trade(const Trade& trade) {
+    auto it = active_orders_.find(trade.maker_id);
+    if (it != active_orders_.end()) {
+        if (it->second.side == Side::BUY) {
+            inventory_ += trade.quantity;
+        } else {
+            inventory_ -= trade.quantity;
+        }
+        pnl_ += trade.quantity * trade.price;
+        active_orders_.erase(it);
+    }
+}
+
+void HawkesTrader::reset() {
+    rng_.seed(rng_.get_seed());
+    inventory_ = 0;
+    pnl_ = 0.0;
+    for (int stream = 0; stream < kStreams; ++stream) {
+        excitation_[stream] = 0.0;
+    }
+    excitation_time_ = 0;
+    next_event_time_ = 0;
+    next_stream_ = -1;
+    active_orders_.clear();
+    reference_price_ = 10000;
+}
+
+double HawkesTrader::stream_intensity(int stream, const double* excitation) const {
+    switch (stream) {
+        case BUY:
+            return config_.mu_buy + config_.self_excitation * excitation[BUY] +
+                   config_.cross_excitation * excitation[SELL];
+        case SELL:
+            return config_.mu_sell + config_.self_excitation * excitation[SELL] +
+                   config_.cross_excitation * excitation[BUY];
+        default:
+            return config_.mu_cancel + config_.self_excitation * excitation[CANCEL] +
+                   config_.cancel_excitation * (excitation[BUY] + excitation[SELL]);
+    }
+}
+
+double HawkesTrader::total_intensity(const double* excitation) const {
+    return stream_intensity(BUY, excitation) + stream_intensity(SELL, excitation) +
+           stream_intensity(CANCEL, excitation);
+}
+
+void HawkesTrader::decay_excitation_to(Timestamp timestamp) {
+    if (timestamp <= excitation_time_) {
+        return;
+    }
+    double dt = static_cast<double>(timestamp - excitation_time_) / 1000000.0;
+    double decay = std::exp(-config_.decay * dt);
+    for (int stream = 0; stream < kStreams; ++stream) {
+        excitation_[stream] *= decay;
+    }
+    excitation_time_ = timestamp;
+}
+
+void HawkesTrader::schedule_next_event(Timestamp current_time) {
+    decay_excitation_to(current_time);
+
+    // Ogata thinning. Between arrivals every intensity decays
+    // monotonically, so the total intensity at the current candidate time
+    // is an exact upper bound over the interval ahead; each rejection
+    // tightens the bound, and each round is O(1) in history length.
+    double local[kStreams] = {excitation_[BUY], excitation_[SELL], excitation_[CANCEL]};
+    double offset = 0.0;
+
+    constexpr int kMaxThinningRounds = 64;
+    for (int round = 0; round < kMaxThinningRounds; ++round) {
+        double bound = total_intensity(local);
+        if (bound <= 0.0) {
+            // Degenerate configuration: no baseline rate and no residual
+            // excitation, so the process never fires again
+            next_stream_ = -1;
+            next_event_time_ = std::numeric_limits<Timestamp>::max();
+            return;
+        }
+
+        double wait = rng_.exponential(bound);
+        offset += wait;
+        double decay = std::exp(-config_.decay * wait);
+        for (int stream = 0; stream < kStreams; ++stream) {
+            local[stream] *= decay;
+        }
+
+        double total = total_intensity(local);
+        if (rng_.uniform_real() * bound <= total) {
+            // Accepted: attribute the arrival to a stream by its share of
+            // the intensity at the arrival time
+            double u = rng_.uniform_real() * total;
+            int stream = BUY;
+            double cumulative = stream_intensity(BUY, local);
+            if (u > cumulative) {
+                stream = SELL;
+                cumulative += stream_intensity(SELL, local);
+            }
+            if (u > cumulative) {
+                stream = CANCEL;
+            }
+            next_stream_ = stream;
+            next_event_time_ = current_time + static_cast<Timestamp>(offset * 1000000.0);
+            if (next_event_time_ <= current_time) {
+                next_event_time_ = current_time + 1;
+            }
+            return;
+        }
+    }
+
+    // Acceptance probability is at least mu_total / bound, so exhausting
+    // the rounds is vanishingly rare; fall back to a baseline-rate draw
+    next_stream_ = rng_.bernoulli(0.5) ? BUY : SELL;
+    next_event_time_ = current_time +
+        static_cast<Timestamp>((offset + rng_.exponential(total_intensity(local))) * 1000000.0);
+}
+
+Qty HawkesTrader::generate_order_quantity() {
+    double quantity = rng_.normal(config_.quantity_mean, config_.quantity_std);
+    return std::max(static_cast<Qty>(1), static_cast<Qty>(std::round(quantity)));
+}
+
+Price HawkesTrader::generate_limit_price(Side side, Price reference_price) {
+    double price_offset = rng_.normal(0, config_.price_volatility);
+    Price price = reference_price + static_cast<Price>(std::round(price_offset));
+    return std::max(static_cast<Price>(1), price);
+}
+
+void HawkesTrader::save_state(std::ostream& out) const {
+    checkpoint::write_pod(out, rng_.get_state());
+    checkpoint::write_pod(out, inventory_);
+    checkpoint::write_pod(out, pnl_);
+    for (int stream = 0; stream < kStreams; ++stream) {
+        checkpoint::write_pod(out, excitation_[stream]);
+    }
+    checkpoint::write_pod(out, excitation_time_);
+    checkpoint::write_pod(out, next_event_time_);
+    checkpoint::write_pod(out, next_stream_);
+    checkpoint::write_pod(out, reference_price_);
+    checkpoint::write_pod(out, static_cast<uint64_t>(active_orders_.size()));
+    for (const auto& [order_id, order] : active_orders_) {
+        checkpoint::write_pod(out, order);
+    }
+}
+
+bool HawkesTrader::load_state(std::istream& in) {
+    RNG::State rng_state;
+    if (!checkpoint::read_pod(in, rng_state)) {
+        return false;
+    }
+    rng_.set_state(rng_state);
+    if (!checkpoint::read_pod(in, inventory_) ||
+        !checkpoint::read_pod(in, pnl_)) {
+        return false;
+    }
+    for (int stream = 0; stream < kStreams; ++stream) {
+        if (!checkpoint::read_pod(in, excitation_[stream])) {
+            return false;
+        }
+    }
+    if (!checkpoint::read_pod(in, excitation_time_) ||
+        !checkpoint::read_pod(in, next_event_time_) ||
+        !checkpoint::read_pod(in, next_stream_) ||
+        !checkpoint::read_pod(in, reference_price_)) {
+        return false;
+    }
+    uint64_t n_orders = 0;
+    if (!checkpoint::read_pod(in, n_orders)) {
+        return false;
+    }
+    active_orders_.clear();
+    for (uint64_t i = 0; i < n_orders; ++i) {
+        Order order;
+        if (!checkpoint::read_pod(in, order)) {
+            return false;
+        }
+        active_orders_[order.id] = order;
+    }
+    return true;
+}
+
+// NoiseTraderPopulation implementation
+NoiseTraderPopulation::NoiseTraderPopulation(OrderId first_id, size_t count,
+                                             const NoiseTrader::Config& config, RNG& rng)
+    : config_(config), rng_(rng.stream(first_id)), first_id_(first_id),
+      inventory_(count), pnl_(count), next_limit_order_time_(count),
+      next_cancel_time_(count), active_orders_(count) {
+    reset();
+}
+
+void NoiseTraderPopulation::step_all(Timestamp timestamp, EventBuffer& events) {
+    const size_t count = inventory_.size();
+    for (size_t i = 0; i < count; ++i) {
+        OrderId agent_id = first_id_ + i;
+
+        // Limit order placement; mirrors NoiseTrader::step
+        if (timestamp >= next_limit_order_time_[i]) {
+            double raw_quantity = rng_.normal(config_.quantity_mean, config_.quantity_std);
+            Qty quantity = std::max(static_cast<Qty>(1),
+                                    static_cast<Qty>(std::round(raw_quantity)));
+            Side side = rng_.bernoulli(0.5) ? Side::BUY : Side::SELL;
+            double price_offset = rng_.normal(0, config_.price_volatility);
+            Price price = std::max(static_cast<Price>(1),
+                                   reference_price_ + static_cast<Price>(std::round(price_offset)));
+
+            OrderId order_id = timestamp + agent_id + rng_.uniform_int(0, 1000);
+            events.emplace_back(EventType::LIMIT, order_id, side, price, quantity,
+                                timestamp, agent_id);
+
+            active_orders_[i].emplace_back(order_id, side, price, quantity, timestamp);
+            order_owner_[order_id] = i;
+
+            double inter_arrival = rng_.exponential(config_.limit_intensity);
+            next_limit_order_time_[i] =
+                timestamp + static_cast<Timestamp>(inter_arrival * 1000000);
+        }
+
+        // Order cancellation
+        if (timestamp >= next_cancel_time_[i]) {
+            auto& orders = active_orders_[i];
+            if (!orders.empty() && rng_.bernoulli(config_.cancel_probability)) {
+                size_t pick = rng_.uniform_int<size_t>(0, orders.size() - 1);
+                OrderId order_id = orders[pick].id;
+                events.emplace_back(EventType::CANCEL, order_id, Side::BUY, 0, 0,
+                                    timestamp, agent_id);
+                order_owner_.erase(order_id);
+                orders[pick] = orders.back();
+                orders.pop_back();
+            }
+            double inter_arrival = rng_.exponential(config_.cancel_intensity);
+            next_cancel_time_[i] =
+                timestamp + static_cast<Timestamp>(inter_arrival * 1000000);
+        }
+    }
+}
+
+void NoiseTraderPopulation::on_trade(const Trade& trade) {
+    // trade.maker_id is the resting order's ID; route via the owner map
+    // instead of asking every member
+    auto it = order_owner_.find(trade.maker_id);
+    if (it == order_owner_.end()) {
+        return;
+    }
+    size_t member = it->second;
+
+    auto& orders = active_orders_[member];
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (orders[i].id == trade.maker_id) {
+            if (orders[i].side == Side::BUY) {
+                inventory_[member] += trade.quantity;
+            } else {
+                inventory_[member] -= trade.quantity;
+            }
+            pnl_[member] += trade.quantity * trade.price;
+            orders[i] = orders.back();
+            orders.pop_back();
+            break;
+        }
+    }
+    order_owner_.erase(it);
+}
+
+std::string NoiseTraderPopulation::name_of(size_t index) const {
+    return "NoiseTrader_" + std::to_string(first_id_ + index);
+}
+
+void NoiseTraderPopulation::reset() {
+    rng_.seed(rng_.get_seed());
+    std::fill(inventory_.begin(), inventory_.end(), 0);
+    std::fill(pnl_.begin(), pnl_.end(), 0.0);
+    std::fill(next_limit_order_time_.begin(), next_limit_order_time_.end(), 0);
+    std::fill(next_cancel_time_.begin(), next_cancel_time_.end(), 0);
+    for (auto& orders : active_orders_) {
+        orders.clear();
+    }
+    order_owner_.clear();
+    reference_price_ = 10000;
+}
+
+void NoiseTraderPopulation::save_state(std::ostream& out) const {
+    checkpoint::write_pod(out, rng_.get_state());
+    checkpoint::write_pod(out, reference_price_);
+    const size_t count = inventory_.size();
+    for (size_t i = 0; i < count; ++i) {
+        checkpoint::write_pod(out, inventory_[i]);
+        checkpoint::write_pod(out, pnl_[i]);
+        checkpoint::write_pod(out, next_limit_order_time_[i]);
+        checkpoint::write_pod(out, next_cancel_time_[i]);
+        checkpoint::write_pod(out, static_cast<uint64_t>(active_orders_[i].size()));
+        for (const auto& order : active_orders_[i]) {
+            checkpoint::write_pod(out, order);
+        }
+    }
+}
+
+bool NoiseTraderPopulation::load_state(std::istream& in) {
+    RNG::State rng_state;
+    if (!checkpoint::read_pod(in, rng_state)) {
+        return false;
+    }
+    rng_.set_state(rng_state);
+    if (!checkpoint::read_pod(in, reference_price_)) {
+        return false;
+    }
+    order_owner_.clear();
+    const size_t count = inventory_.size();
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t n_orders = 0;
+        if (!checkpoint::read_pod(in, inventory_[i]) ||
+            !checkpoint::read_pod(in, pnl_[i]) ||
+            !checkpoint::read_pod(in, next_limit_order_time_[i]) ||
+            !checkpoint::read_pod(in, next_cancel_time_[i]) ||
+            !checkpoint::read_pod(in, n_orders)) {
+            return false;
+        }
+        active_orders_[i].clear();
+        for (uint64_t j = 0; j < n_orders; ++j) {
+            Order order;
+            if (!checkpoint::read_pod(in, order)) {
+                return false;
+            }
+            active_orders_[i].push_back(order);
+            order_owner_[order.id] = i;
+        }
+    }
+    return true;
+}
+
 // AgentManager implementation
 void AgentManager::add_agent(std::unique_ptr<Agent> agent) {
     if (agent) {
@@ -315,26 +802,131 @@ void AgentManager::add_agent(std::unique_ptr<Agent> agent) {
     }
 }
 
+void AgentManager::add_population(std::unique_ptr<AgentPopulation> population) {
+    if (population) {
+        populations_.push_back(std::move(population));
+    }
+}
+
 Agent* AgentManager::get_agent(OrderId id) const {
     auto it = agent_lookup_.find(id);
     return it != agent_lookup_.end() ? it->second : nullptr;
 }
 
 std::vector<Event> AgentManager::step(Timestamp timestamp) {
+#if MMS_INSTRUMENTATION
+    instrumentation::ScopedLatencyTimer timer(step_latency_);
+#endif
     std::vector<Event> all_events;
     
     for (auto& agent : agents_) {
         auto events = agent->step(timestamp);
         all_events.insert(all_events.end(), events.begin(), events.end());
     }
+    for (auto& population : populations_) {
+        population->step_all(timestamp, all_events);
+    }
     
     return all_events;
 }
 
+void AgentManager::step(Timestamp timestamp, std::pmr::vector<Event>& out) {
+#if MMS_INSTRUMENTATION
+    instrumentation::ScopedLatencyTimer timer(step_latency_);
+#endif
+    for (auto& agent : agents_) {
+        auto events = agent->step(timestamp);
+        out.insert(out.end(), events.begin(), events.end());
+    }
+    if (!populations_.empty()) {
+        EventBuffer buffer;
+        for (auto& population : populations_) {
+            population->step_all(timestamp, buffer);
+        }
+        out.insert(out.end(), buffer.begin(), buffer.end());
+    }
+}
+
+void AgentManager::step_parallel(Timestamp timestamp, std::pmr::vector<Event>& out, size_t n_threads) {
+#if MMS_INSTRUMENTATION
+    instrumentation::ScopedLatencyTimer timer(step_latency_);
+#endif
+    const size_t n_units = agents_.size() + populations_.size();
+    if (n_units == 0) {
+        return;
+    }
+    n_threads = std::min(std::max<size_t>(1, n_threads), n_units);
+
+    // One buffer per agent/population: output is keyed by the unit, not
+    // by which worker happened to run it, so any thread count fills the
+    // same buffers with the same contents
+    std::vector<EventBuffer> buffers(n_units);
+    auto step_unit = [&](size_t unit) {
+        if (unit < agents_.size()) {
+            auto events = agents_[unit]->step(timestamp);
+            buffers[unit].assign(events.begin(), events.end());
+        } else {
+            populations_[unit - agents_.size()]->step_all(timestamp, buffers[unit]);
+        }
+    };
+
+    if (n_threads == 1) {
+        for (size_t unit = 0; unit < n_units; ++unit) {
+            step_unit(unit);
+        }
+    } else {
+        std::atomic<size_t> next_unit{0};
+        std::vector<std::thread> workers;
+        workers.reserve(n_threads);
+        for (size_t t = 0; t < n_threads; ++t) {
+            workers.emplace_back([&] {
+                for (size_t unit = next_unit.fetch_add(1); unit < n_units;
+                     unit = next_unit.fetch_add(1)) {
+                    step_unit(unit);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Deterministic merge by (timestamp, agent ID); the stable sort over
+    // the unit-ordered concatenation keeps each agent's own events in
+    // generation order
+    const auto first = static_cast<std::ptrdiff_t>(out.size());
+    for (const auto& buffer : buffers) {
+        out.insert(out.end(), buffer.begin(), buffer.end());
+    }
+    std::stable_sort(out.begin() + first, out.end(), [](const Event& a, const Event& b) {
+        if (a.timestamp != b.timestamp) {
+            return a.timestamp < b.timestamp;
+        }
+        return a.agent_id < b.agent_id;
+    });
+}
+
+void AgentManager::notify_trade(const Trade& trade, OrderId maker_agent, OrderId taker_agent) {
+    if (Agent* maker = get_agent(maker_agent)) {
+        maker->on_trade(trade);
+    }
+    if (taker_agent != maker_agent) {
+        if (Agent* taker = get_agent(taker_agent)) {
+            taker->on_trade(trade);
+        }
+    }
+    for (auto& population : populations_) {
+        population->on_trade(trade);
+    }
+}
+
 void AgentManager::notify_trade(const Trade& trade) {
     for (auto& agent : agents_) {
         agent->on_trade(trade);
     }
+    for (auto& population : populations_) {
+        population->on_trade(trade);
+    }
 }
 
 std::vector<AgentManager::AgentStats> AgentManager::get_stats() const {
@@ -349,14 +941,57 @@ std::vector<AgentManager::AgentStats> AgentManager::get_stats() const {
             0 // trade_count would need to be tracked separately
         });
     }
+    for (const auto& population : populations_) {
+        for (size_t i = 0; i < population->size(); ++i) {
+            stats.push_back({
+                population->id_of(i),
+                population->name_of(i),
+                population->pnl_of(i),
+                population->inventory_of(i),
+                0
+            });
+        }
+    }
     
     return stats;
 }
 
+void AgentManager::save_state(std::ostream& out) const {
+    for (const auto& agent : agents_) {
+        agent->save_state(out);
+    }
+    for (const auto& population : populations_) {
+        population->save_state(out);
+    }
+}
+
+bool AgentManager::load_state(std::istream& in) {
+    for (auto& agent : agents_) {
+        if (!agent->load_state(in)) {
+            return false;
+        }
+    }
+    for (auto& population : populations_) {
+        if (!population->load_state(in)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void AgentManager::reset() {
     for (auto& agent : agents_) {
         agent->reset();
     }
+    for (auto& population : populations_) {
+        population->reset();
+    }
+}
+
+void AgentManager::clear() {
+    agents_.clear();
+    populations_.clear();
+    agent_lookup_.clear();
 }
 
 } // namespace mms
@@ -0,0 +1,93 @@
+#include "mms/differential.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace mms {
+
+DifferentialRunner::DifferentialRunner(const DifferentialConfig& config)
+    : config_(config) {}
+
+DifferentialResult DifferentialRunner::run() {
+    SimulationConfig run_config = config_.base;
+    run_config.output_dir.clear(); // No per-arm file dumps
+
+    size_t divergence = std::min(config_.divergence_step, config_.n_steps);
+    size_t suffix_steps = config_.n_steps - divergence;
+
+    DifferentialResult result;
+    result.divergence_step = divergence;
+
+    // Shared prefix: both arms are bit-identical before the divergence,
+    // so simulate it once under the baseline configs
+    Simulator baseline_sim(run_config);
+    result.prefix = baseline_sim.run(divergence,
+                                     config_.baseline.maker_config,
+                                     config_.baseline.taker_config,
+                                     config_.baseline.noise_config);
+
+    // Fork the full simulation state (book, agent state, RNG streams) at
+    // the divergence point into an in-memory checkpoint
+    std::stringstream fork(std::ios::in | std::ios::out | std::ios::binary);
+    baseline_sim.save_checkpoint(fork);
+
+    // Baseline arm continues in place. Collection restarts at the fork
+    // so both arms report the post-divergence window only, which keeps
+    // every delta below a paired comparison over identical windows.
+    baseline_sim.get_data_collector().clear();
+    result.baseline = baseline_sim.resume(suffix_steps);
+
+    // Variant arm: a fresh simulator registers the same agent lineup
+    // under the variant configs, then rewinds onto the forked state.
+    // load_state restores per-agent state but not parameters, so the
+    // variant configs take effect exactly at the divergence step.
+    Simulator variant_sim(run_config);
+    variant_sim.run(0,
+                    config_.variant.maker_config,
+                    config_.variant.taker_config,
+                    config_.variant.noise_config);
+    variant_sim.restore_checkpoint(fork);
+    variant_sim.get_data_collector().clear();
+    result.variant = variant_sim.resume(suffix_steps);
+
+    // Paired market statistics over the post-divergence window
+    auto baseline_spread = analysis::calculate_spread_stats(result.baseline.market_snapshots);
+    auto variant_spread = analysis::calculate_spread_stats(result.variant.market_snapshots);
+    result.mean_spread_delta = variant_spread.mean_spread - baseline_spread.mean_spread;
+    result.median_spread_delta = variant_spread.median_spread - baseline_spread.median_spread;
+    result.volatility_delta =
+        analysis::calculate_realized_volatility(result.variant.market_snapshots) -
+        analysis::calculate_realized_volatility(result.baseline.market_snapshots);
+    result.vwap_delta = analysis::calculate_vwap(result.variant.trades) -
+                        analysis::calculate_vwap(result.baseline.trades);
+    result.trade_count_delta = static_cast<int64_t>(result.variant.total_trades) -
+                               static_cast<int64_t>(result.baseline.total_trades);
+
+    // Paired per-agent performance, matched by agent ID
+    result.baseline_performance =
+        analysis::calculate_agent_performance(result.baseline.agent_pnl, result.baseline.trades);
+    result.variant_performance =
+        analysis::calculate_agent_performance(result.variant.agent_pnl, result.variant.trades);
+    auto by_agent = [](const analysis::AgentPerformance& a, const analysis::AgentPerformance& b) {
+        return a.agent_id < b.agent_id;
+    };
+    std::sort(result.baseline_performance.begin(), result.baseline_performance.end(), by_agent);
+    std::sort(result.variant_performance.begin(), result.variant_performance.end(), by_agent);
+    for (const auto& variant_perf : result.variant_performance) {
+        for (const auto& baseline_perf : result.baseline_performance) {
+            if (baseline_perf.agent_id == variant_perf.agent_id) {
+                AgentDelta delta;
+                delta.agent_id = variant_perf.agent_id;
+                delta.pnl_delta = variant_perf.total_pnl - baseline_perf.total_pnl;
+                delta.sharpe_delta = variant_perf.sharpe_ratio - baseline_perf.sharpe_ratio;
+                delta.max_drawdown_delta =
+                    variant_perf.max_drawdown - baseline_perf.max_drawdown;
+                result.agent_deltas.push_back(delta);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace mms
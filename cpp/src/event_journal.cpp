@@ -0,0 +1,179 @@
+#include "mms/event_journal.hpp"
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mms {
+
+namespace {
+
+constexpr char kJournalMagic[4] = {'M', 'M', 'S', 'J'};
+constexpr uint32_t kJournalVersion = 1;
+constexpr size_t kInitialCapacity = 1 << 20; // 1 MiB
+
+// Counts trades during replay without storing them
+class CountingTradeSink : public TradeSink {
+public:
+    void accept(const Trade&) override { count_++; }
+    size_t count() const { return count_; }
+
+private:
+    size_t count_ = 0;
+};
+
+} // namespace
+
+// EventJournalWriter implementation
+EventJournalWriter::EventJournalWriter(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        return;
+    }
+    remap(kInitialCapacity);
+    if (base_ == nullptr) {
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+
+    auto* header = reinterpret_cast<EventJournalHeader*>(base_);
+    std::memcpy(header->magic, kJournalMagic, sizeof(kJournalMagic));
+    header->version = kJournalVersion;
+    header->event_size = static_cast<uint32_t>(sizeof(Event));
+    header->reserved = 0;
+    header->count = 0;
+}
+
+EventJournalWriter::~EventJournalWriter() {
+    close();
+}
+
+void EventJournalWriter::remap(size_t new_capacity) {
+    if (base_ != nullptr) {
+        ::munmap(base_, capacity_);
+        base_ = nullptr;
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(new_capacity)) != 0) {
+        return;
+    }
+    void* mapped = ::mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        return;
+    }
+    base_ = static_cast<char*>(mapped);
+    capacity_ = new_capacity;
+}
+
+void EventJournalWriter::append(const Event& event) {
+    if (base_ == nullptr) {
+        return;
+    }
+    size_t offset = sizeof(EventJournalHeader) + count_ * sizeof(Event);
+    if (offset + sizeof(Event) > capacity_) {
+        remap(capacity_ * 2);
+        if (base_ == nullptr) {
+            return;
+        }
+    }
+    std::memcpy(base_ + offset, &event, sizeof(Event));
+    count_++;
+    reinterpret_cast<EventJournalHeader*>(base_)->count = count_;
+}
+
+void EventJournalWriter::close() {
+    if (base_ != nullptr) {
+        ::munmap(base_, capacity_);
+        base_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        // Trim the preallocated tail so the file ends at the last event
+        ::ftruncate(fd_, static_cast<off_t>(sizeof(EventJournalHeader) + count_ * sizeof(Event)));
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// EventJournalReader implementation
+EventJournalReader::EventJournalReader(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        return;
+    }
+    struct stat info;
+    if (::fstat(fd_, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(EventJournalHeader)) {
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+    mapped_bytes_ = static_cast<size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, mapped_bytes_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+    base_ = static_cast<const char*>(mapped);
+
+    const auto* header = reinterpret_cast<const EventJournalHeader*>(base_);
+    bool valid = std::memcmp(header->magic, kJournalMagic, sizeof(kJournalMagic)) == 0 &&
+                 header->version == kJournalVersion &&
+                 header->event_size == sizeof(Event);
+    size_t available = (mapped_bytes_ - sizeof(EventJournalHeader)) / sizeof(Event);
+    if (!valid || header->count > available) {
+        ::munmap(const_cast<char*>(base_), mapped_bytes_);
+        base_ = nullptr;
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+
+    events_ = std::span<const Event>(
+        reinterpret_cast<const Event*>(base_ + sizeof(EventJournalHeader)), header->count);
+}
+
+EventJournalReader::~EventJournalReader() {
+    if (base_ != nullptr) {
+        ::munmap(const_cast<char*>(base_), mapped_bytes_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+// ReplayDriver implementation
+ReplayDriver::ReplayResult ReplayDriver::replay(MatchingEngine& engine) {
+    ReplayResult result;
+    if (!reader_.is_open()) {
+        return result;
+    }
+
+    CountingTradeSink sink;
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    engine.process_events(reader_.events(), sink);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+    result.events_replayed = reader_.count();
+    result.trades = sink.count();
+    result.wall_time_seconds = static_cast<double>(duration.count()) / 1e9;
+    if (result.wall_time_seconds > 0.0) {
+        result.events_per_second =
+            static_cast<double>(result.events_replayed) / result.wall_time_seconds;
+    }
+    return result;
+}
+
+namespace detail {
+
+void journal_append(EventJournalWriter* journal, const Event& event) {
+    journal->append(event);
+}
+
+} // namespace detail
+
+} // namespace mms
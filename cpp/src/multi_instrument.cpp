@@ -0,0 +1,105 @@
+#include "mms/multi_instrument.hpp"
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <thread>
+
+namespace mms {
+
+MultiInstrumentSimulator::MultiInstrumentSimulator(const MultiInstrumentConfig& config)
+    : config_(config) {
+    size_t hw = std::thread::hardware_concurrency();
+    if (hw == 0) {
+        hw = 1;
+    }
+    n_shards_ = config_.n_threads > 0 ? config_.n_threads : hw;
+    n_shards_ = std::min(n_shards_, std::max<size_t>(1, config_.n_instruments));
+}
+
+MultiInstrumentSimulator::RunResult MultiInstrumentSimulator::run(size_t n_steps) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    std::vector<Simulator::RunResult> results(config_.n_instruments);
+
+    // One shard per thread; instrument i is pinned to shard i % n_shards.
+    // Each shard owns its simulators outright, so threads share nothing.
+    std::vector<std::thread> shards;
+    shards.reserve(n_shards_);
+
+    for (size_t shard = 0; shard < n_shards_; ++shard) {
+        shards.emplace_back([this, shard, n_steps, &results]() {
+            for (size_t i = shard; i < config_.n_instruments; i += n_shards_) {
+                SimulationConfig sim_config = config_.base;
+                sim_config.seed = config_.base.seed + i;
+                sim_config.output_dir.clear(); // No per-instrument CSV dumps
+
+                Simulator simulator(sim_config);
+                results[i] = simulator.run(n_steps, config_.maker_config,
+                                           config_.taker_config, config_.noise_config);
+            }
+        });
+    }
+
+    for (auto& shard : shards) {
+        shard.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    RunResult result;
+    result.merged_trades = merge_trades(results);
+    for (const auto& instrument_result : results) {
+        result.total_events_processed += instrument_result.total_events_processed;
+        result.total_trades += instrument_result.total_trades;
+    }
+    result.instruments = std::move(results);
+    result.wall_time_seconds = static_cast<double>(duration.count()) / 1e6;
+
+    return result;
+}
+
+std::vector<MultiInstrumentSimulator::InstrumentTrade>
+MultiInstrumentSimulator::merge_trades(const std::vector<Simulator::RunResult>& results) {
+    // K-way merge over the per-instrument trade streams, each of which is
+    // already timestamp-ordered
+    struct Cursor {
+        size_t instrument_id;
+        size_t position;
+    };
+    auto compare = [&results](const Cursor& a, const Cursor& b) {
+        const Trade& ta = results[a.instrument_id].trades[a.position];
+        const Trade& tb = results[b.instrument_id].trades[b.position];
+        if (ta.timestamp != tb.timestamp) {
+            return ta.timestamp > tb.timestamp; // min-heap on timestamp
+        }
+        return a.instrument_id > b.instrument_id;
+    };
+
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(compare)> heap(compare);
+    size_t total = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        total += results[i].trades.size();
+        if (!results[i].trades.empty()) {
+            heap.push(Cursor{i, 0});
+        }
+    }
+
+    std::vector<InstrumentTrade> merged;
+    merged.reserve(total);
+
+    while (!heap.empty()) {
+        Cursor cursor = heap.top();
+        heap.pop();
+        merged.push_back(InstrumentTrade{cursor.instrument_id,
+                                         results[cursor.instrument_id].trades[cursor.position]});
+        cursor.position++;
+        if (cursor.position < results[cursor.instrument_id].trades.size()) {
+            heap.push(cursor);
+        }
+    }
+
+    return merged;
+}
+
+} // namespace mms
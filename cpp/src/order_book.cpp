@@ -1,136 +1,370 @@
 #include "mms/order_book.hpp"
+#include "mms/checkpoint.hpp"
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 namespace mms {
 
+OrderBook::OrderBook(const LadderConfig& ladder_config) {
+    ladder_enabled_ = true;
+    ladder_low_ = std::max<Price>(1, ladder_config.anchor_price - ladder_config.half_width);
+    Price ladder_high = ladder_config.anchor_price + ladder_config.half_width;
+    size_t n_levels = static_cast<size_t>(ladder_high - ladder_low_ + 1);
+    ladder_bid_levels_.resize(n_levels);
+    ladder_ask_levels_.resize(n_levels);
+    bid_occupancy_.resize((n_levels + 63) / 64, 0);
+    ask_occupancy_.resize((n_levels + 63) / 64, 0);
+}
+
+void OrderBook::reserve(size_t n_orders) {
+    node_pool_.reserve(n_orders);
+    free_nodes_.reserve(n_orders);
+    order_lookup_.reserve(n_orders);
+}
+
+OrderNodeIndex OrderBook::allocate_node(const Order& order) {
+    OrderNodeIndex index;
+    if (!free_nodes_.empty()) {
+        index = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        index = static_cast<OrderNodeIndex>(node_pool_.size());
+        node_pool_.emplace_back();
+    }
+    node_pool_[index].order = order;
+    node_pool_[index].prev = kNullOrderNode;
+    node_pool_[index].next = kNullOrderNode;
+    return index;
+}
+
+void OrderBook::free_node(OrderNodeIndex index) {
+    free_nodes_.push_back(index);
+}
+
+long OrderBook::lowest_occupied(const std::vector<uint64_t>& bitmap) const {
+    return lowest_occupied(bitmap, 0);
+}
+
+long OrderBook::lowest_occupied(const std::vector<uint64_t>& bitmap, size_t from) const {
+    size_t start_word = from >> 6;
+    for (size_t w = start_word; w < bitmap.size(); ++w) {
+        uint64_t word = bitmap[w];
+        if (w == start_word) {
+            word &= ~uint64_t{0} << (from & 63); // Mask bits below the start
+        }
+        if (word != 0) {
+            return static_cast<long>(w * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+        }
+    }
+    return -1;
+}
+
+long OrderBook::highest_occupied(const std::vector<uint64_t>& bitmap) const {
+    if (bitmap.empty()) {
+        return -1;
+    }
+    return highest_occupied(bitmap, bitmap.size() * 64 - 1);
+}
+
+long OrderBook::highest_occupied(const std::vector<uint64_t>& bitmap, size_t from) const {
+    size_t start_word = std::min(from >> 6, bitmap.size() - 1);
+    for (size_t w = start_word + 1; w-- > 0; ) {
+        uint64_t word = bitmap[w];
+        if (w == start_word && (from & 63) != 63) {
+            word &= (uint64_t{1} << ((from & 63) + 1)) - 1; // Mask bits above the start
+        }
+        if (word != 0) {
+            return static_cast<long>(w * 64 + (63 - static_cast<size_t>(__builtin_clzll(word))));
+        }
+    }
+    return -1;
+}
+
 bool OrderBook::add_limit_order(const Order& order) {
+    TradeList trades(trade_memory_);
+    return add_limit_order(order, trades);
+}
+
+bool OrderBook::add_limit_order(const Order& order, TradeList& trades,
+                                const std::unordered_set<OrderId>* excluded_makers) {
     if (!is_valid_price(order.price) || !is_valid_quantity(order.quantity)) {
         return false;
     }
-    
-    return add_limit_order_to_side(order);
+    if (ladder_enabled_ && !in_ladder_range(order.price)) {
+        return false; // Outside the configured tick band
+    }
+
+    // Match against the opposite side first (crossing orders execute at the
+    // resting order's price), then rest any remainder in the book.
+    Qty remaining_qty = order.quantity;
+    if (order.side == Side::BUY) {
+        match_against_asks(order.quantity, order.price, order.id, order.timestamp, trades,
+                           remaining_qty, excluded_makers);
+    } else {
+        match_against_bids(order.quantity, order.price, order.id, order.timestamp, trades,
+                           remaining_qty, excluded_makers);
+    }
+
+    version_++;
+
+    if (remaining_qty > 0) {
+        if (!admit_resting_order(order)) {
+            // Matched fills stand; only the remainder is dropped
+            return !trades.empty();
+        }
+        Order resting = order;
+        resting.quantity = remaining_qty;
+        return add_limit_order_to_side(resting);
+    }
+
+    return true;
+}
+
+bool OrderBook::admit_resting_order(const Order& order) {
+    // Band check against the current mid (falling back to the last trade
+    // price when one side is empty; an empty book admits everything)
+    if (admission_.max_distance_from_mid > 0) {
+        auto bid = best_bid_price();
+        auto ask = best_ask_price();
+        Price reference = 0;
+        if (bid && ask) {
+            reference = (*bid + *ask) / 2;
+        } else if (last_trade_price_ > 0) {
+            reference = last_trade_price_;
+        }
+        if (reference > 0) {
+            Price distance = order.price > reference ? order.price - reference
+                                                     : reference - order.price;
+            if (distance > admission_.max_distance_from_mid) {
+                rejected_band_count_++;
+                return false;
+            }
+        }
+    }
+
+    if (admission_.max_orders_per_side > 0) {
+        size_t side_count = order.side == Side::BUY ? bid_order_count_ : ask_order_count_;
+        if (side_count >= admission_.max_orders_per_side) {
+            rejected_cap_count_++;
+            return false;
+        }
+    }
+
+    return true;
 }
 
 bool OrderBook::add_limit_order_to_side(const Order& order) {
+    OrderNodeIndex index = allocate_node(order);
+
     // Add to appropriate side
-    if (order.side == Side::BUY) {
-        buy_levels_[order.price].add_order(order);
+    if (ladder_enabled_) {
+        size_t slot = ladder_index(order.price);
+        if (order.side == Side::BUY) {
+            ladder_bid_levels_[slot].add_node(node_pool_, index);
+            set_occupancy(bid_occupancy_, slot);
+        } else {
+            ladder_ask_levels_[slot].add_node(node_pool_, index);
+            set_occupancy(ask_occupancy_, slot);
+        }
     } else {
-        sell_levels_[order.price].add_order(order);
+        if (order.side == Side::BUY) {
+            buy_levels_[order.price].add_node(node_pool_, index);
+        } else {
+            sell_levels_[order.price].add_node(node_pool_, index);
+        }
     }
-    
-    // Update order lookup for cancellations
-    order_lookup_[order.id] = std::make_pair(order.price, order.side);
+
+    // Direct node reference for O(1) cancellation
+    order_lookup_[order.id] = index;
     order_count_++;
-    
+    if (order.side == Side::BUY) {
+        bid_order_count_++;
+    } else {
+        ask_order_count_++;
+    }
+
     return true;
 }
 
-std::vector<Trade> OrderBook::add_market_order(Side side, Qty quantity, OrderId taker_id, Timestamp timestamp) {
+TradeList OrderBook::add_market_order(Side side, Qty quantity, OrderId taker_id, Timestamp timestamp,
+                                      const std::unordered_set<OrderId>* excluded_makers) {
+    TradeList trades(trade_memory_);
+    Qty remaining_qty = quantity;
+
     if (side == Side::BUY) {
-        return match_market_order_buy(quantity, taker_id, timestamp);
+        // Market buy has no price limit
+        match_against_asks(quantity, std::numeric_limits<Price>::max(), taker_id, timestamp,
+                           trades, remaining_qty, excluded_makers);
     } else {
-        return match_market_order_sell(quantity, taker_id, timestamp);
+        match_against_bids(quantity, 0, taker_id, timestamp, trades, remaining_qty, excluded_makers);
+    }
+
+    if (!trades.empty()) {
+        version_++;
     }
+
+    return trades;
 }
 
-std::vector<Trade> OrderBook::match_market_order_buy(Qty quantity, OrderId taker_id, Timestamp timestamp) {
-    std::vector<Trade> trades;
-    Qty remaining_qty = quantity;
-    
+bool OrderBook::consume_level(OrderBookPriceLevel& level, Price price, OrderId taker_id,
+                              Timestamp timestamp, TradeList& trades, Qty& remaining_qty,
+                              const std::unordered_set<OrderId>* excluded_makers) {
+    OrderNodeIndex index = level.front();
+    while (index != kNullOrderNode && remaining_qty > 0) {
+        OrderNodeIndex next = node_pool_[index].next;
+        Order& maker_order = node_pool_[index].order;
+
+        // Lazy TTL expiry: stale makers are evicted as matching reaches
+        // them instead of via a periodic sweep
+        if (admission_.order_ttl > 0 &&
+            timestamp - maker_order.timestamp > admission_.order_ttl) {
+            expire_node(level, index);
+            index = next;
+            continue;
+        }
+
+        // Self-trade prevention: leave the agent's own resting orders
+        // untouched and keep walking the queue
+        if (excluded_makers != nullptr && excluded_makers->count(maker_order.id) > 0) {
+            index = next;
+            continue;
+        }
+
+        if (maker_order.quantity <= remaining_qty) {
+            // Maker fully consumed
+            Qty fill_qty = maker_order.quantity;
+            trades.emplace_back(maker_order.id, taker_id, price, fill_qty, timestamp);
+            remaining_qty -= fill_qty;
+
+            order_lookup_.erase(maker_order.id);
+            order_count_--;
+            if (maker_order.side == Side::BUY) {
+                bid_order_count_--;
+            } else {
+                ask_order_count_--;
+            }
+            level.remove_node(node_pool_, index);
+            free_node(index);
+
+            last_trade_price_ = price;
+            total_volume_ += fill_qty;
+            trade_count_++;
+        } else {
+            // Partial fill of the maker order
+            Qty fill_qty = remaining_qty;
+            trades.emplace_back(maker_order.id, taker_id, price, fill_qty, timestamp);
+            level.reduce_node_quantity(node_pool_, index, fill_qty);
+            remaining_qty = 0;
+
+            last_trade_price_ = price;
+            total_volume_ += fill_qty;
+            trade_count_++;
+        }
+
+        index = next;
+    }
+
+    return level.empty();
+}
+
+void OrderBook::expire_node(OrderBookPriceLevel& level, OrderNodeIndex index) {
+    const Order& order = node_pool_[index].order;
+    expired_order_ids_.push_back(order.id);
+    order_lookup_.erase(order.id);
+    order_count_--;
+    if (order.side == Side::BUY) {
+        bid_order_count_--;
+    } else {
+        ask_order_count_--;
+    }
+    level.remove_node(node_pool_, index);
+    free_node(index);
+    expired_count_++;
+    // An expiry mutates the book even when the match produces no trades,
+    // so the cached-depth/snapshot dirty checks must see it
+    version_++;
+}
+
+void OrderBook::match_against_asks(Qty quantity, Price price_limit, OrderId taker_id,
+                                   Timestamp timestamp, TradeList& trades, Qty& remaining_qty,
+                                   const std::unordered_set<OrderId>* excluded_makers) {
+    remaining_qty = quantity;
+
+    if (ladder_enabled_) {
+        // Walk ask levels upward from the best via the occupancy bitmap.
+        // A level left non-empty with quantity outstanding held only
+        // excluded makers, so the scan resumes above it.
+        long slot = lowest_occupied(ask_occupancy_);
+        while (slot >= 0 && remaining_qty > 0) {
+            Price price = ladder_low_ + static_cast<Price>(slot);
+            if (price > price_limit) {
+                break; // No more crossing levels
+            }
+            size_t index = static_cast<size_t>(slot);
+            if (consume_level(ladder_ask_levels_[index], price, taker_id, timestamp, trades,
+                              remaining_qty, excluded_makers)) {
+                clear_occupancy(ask_occupancy_, index);
+            }
+            slot = lowest_occupied(ask_occupancy_, index + 1);
+        }
+        return;
+    }
+
     // Match against sell levels (ascending price order)
     for (auto it = sell_levels_.begin(); it != sell_levels_.end() && remaining_qty > 0; ) {
         Price price = it->first;
-        OrderBookPriceLevel& level = it->second;
-        
-        while (!level.empty() && remaining_qty > 0) {
-            Order maker_order;
-            bool fully_consumed = level.consume_order(remaining_qty, maker_order);
-            
-            if (fully_consumed) {
-                // Order fully consumed
-                remaining_qty -= maker_order.quantity;
-                trades.emplace_back(maker_order.id, taker_id, price, maker_order.quantity, timestamp);
-                
-                // Remove from order lookup
-                order_lookup_.erase(maker_order.id);
-                order_count_--;
-                
-                // Update statistics
-                last_trade_price_ = price;
-                total_volume_ += maker_order.quantity;
-                trade_count_++;
-            } else {
-                // Partial fill - remaining_qty is now 0
-                trades.emplace_back(maker_order.id, taker_id, price, remaining_qty, timestamp);
-                remaining_qty = 0;
-                
-                // Update statistics
-                last_trade_price_ = price;
-                total_volume_ += remaining_qty;
-                trade_count_++;
-            }
+        if (price > price_limit) {
+            break; // No more crossing levels
         }
-        
-        // Remove empty price level
-        if (level.empty()) {
+        if (consume_level(it->second, price, taker_id, timestamp, trades, remaining_qty,
+                          excluded_makers)) {
             it = sell_levels_.erase(it);
         } else {
             ++it;
         }
     }
-    
-    return trades;
 }
 
-std::vector<Trade> OrderBook::match_market_order_sell(Qty quantity, OrderId taker_id, Timestamp timestamp) {
-    std::vector<Trade> trades;
-    Qty remaining_qty = quantity;
-    
+void OrderBook::match_against_bids(Qty quantity, Price price_limit, OrderId taker_id,
+                                   Timestamp timestamp, TradeList& trades, Qty& remaining_qty,
+                                   const std::unordered_set<OrderId>* excluded_makers) {
+    remaining_qty = quantity;
+
+    if (ladder_enabled_) {
+        // Walk bid levels downward from the best via the occupancy bitmap
+        long slot = highest_occupied(bid_occupancy_);
+        while (slot >= 0 && remaining_qty > 0) {
+            Price price = ladder_low_ + static_cast<Price>(slot);
+            if (price < price_limit) {
+                break; // No more crossing levels
+            }
+            size_t index = static_cast<size_t>(slot);
+            if (consume_level(ladder_bid_levels_[index], price, taker_id, timestamp, trades,
+                              remaining_qty, excluded_makers)) {
+                clear_occupancy(bid_occupancy_, index);
+            }
+            if (index == 0) {
+                break;
+            }
+            slot = highest_occupied(bid_occupancy_, index - 1);
+        }
+        return;
+    }
+
     // Match against buy levels (descending price order)
     for (auto it = buy_levels_.begin(); it != buy_levels_.end() && remaining_qty > 0; ) {
         Price price = it->first;
-        OrderBookPriceLevel& level = it->second;
-        
-        while (!level.empty() && remaining_qty > 0) {
-            Order maker_order;
-            bool fully_consumed = level.consume_order(remaining_qty, maker_order);
-            
-            if (fully_consumed) {
-                // Order fully consumed
-                remaining_qty -= maker_order.quantity;
-                trades.emplace_back(maker_order.id, taker_id, price, maker_order.quantity, timestamp);
-                
-                // Remove from order lookup
-                order_lookup_.erase(maker_order.id);
-                order_count_--;
-                
-                // Update statistics
-                last_trade_price_ = price;
-                total_volume_ += maker_order.quantity;
-                trade_count_++;
-            } else {
-                // Partial fill - remaining_qty is now 0
-                trades.emplace_back(maker_order.id, taker_id, price, remaining_qty, timestamp);
-                remaining_qty = 0;
-                
-                // Update statistics
-                last_trade_price_ = price;
-                total_volume_ += remaining_qty;
-                trade_count_++;
-            }
+        if (price < price_limit) {
+            break; // No more crossing levels
         }
-        
-        // Remove empty price level
-        if (level.empty()) {
+        if (consume_level(it->second, price, taker_id, timestamp, trades, remaining_qty,
+                          excluded_makers)) {
             it = buy_levels_.erase(it);
         } else {
             ++it;
         }
     }
-    
-    return trades;
 }
 
 bool OrderBook::cancel_order(OrderId order_id) {
@@ -138,47 +372,57 @@ bool OrderBook::cancel_order(OrderId order_id) {
     if (it == order_lookup_.end()) {
         return false; // Order not found
     }
-    
-    Price price = it->second.first;
-    Side side = it->second.second;
-    
-    remove_order_from_side(order_id, price, side);
-    return true;
-}
 
-void OrderBook::remove_order_from_side(OrderId order_id, Price price, Side side) {
-    Order removed_order;
-    
-    if (side == Side::BUY) {
-        auto level_it = buy_levels_.find(price);
-        if (level_it != buy_levels_.end()) {
-            if (level_it->second.remove_order(order_id, removed_order)) {
-                order_lookup_.erase(order_id);
-                order_count_--;
-                
-                // Remove empty price level
-                if (level_it->second.empty()) {
-                    buy_levels_.erase(level_it);
-                }
+    OrderNodeIndex index = it->second;
+    const Order& order = node_pool_[index].order;
+
+    if (ladder_enabled_) {
+        size_t slot = ladder_index(order.price);
+        if (order.side == Side::BUY) {
+            ladder_bid_levels_[slot].remove_node(node_pool_, index);
+            if (ladder_bid_levels_[slot].empty()) {
+                clear_occupancy(bid_occupancy_, slot);
+            }
+        } else {
+            ladder_ask_levels_[slot].remove_node(node_pool_, index);
+            if (ladder_ask_levels_[slot].empty()) {
+                clear_occupancy(ask_occupancy_, slot);
             }
         }
+    } else if (order.side == Side::BUY) {
+        auto level_it = buy_levels_.find(order.price);
+        level_it->second.remove_node(node_pool_, index);
+        if (level_it->second.empty()) {
+            buy_levels_.erase(level_it);
+        }
     } else {
-        auto level_it = sell_levels_.find(price);
-        if (level_it != sell_levels_.end()) {
-            if (level_it->second.remove_order(order_id, removed_order)) {
-                order_lookup_.erase(order_id);
-                order_count_--;
-                
-                // Remove empty price level
-                if (level_it->second.empty()) {
-                    sell_levels_.erase(level_it);
-                }
-            }
+        auto level_it = sell_levels_.find(order.price);
+        level_it->second.remove_node(node_pool_, index);
+        if (level_it->second.empty()) {
+            sell_levels_.erase(level_it);
         }
     }
+
+    if (order.side == Side::BUY) {
+        bid_order_count_--;
+    } else {
+        ask_order_count_--;
+    }
+    free_node(index);
+    order_lookup_.erase(it);
+    order_count_--;
+    version_++;
+    return true;
 }
 
 std::optional<Price> OrderBook::best_bid_price() const {
+    if (ladder_enabled_) {
+        long slot = highest_occupied(bid_occupancy_);
+        if (slot < 0) {
+            return std::nullopt;
+        }
+        return ladder_low_ + static_cast<Price>(slot);
+    }
     if (buy_levels_.empty()) {
         return std::nullopt;
     }
@@ -186,6 +430,13 @@ std::optional<Price> OrderBook::best_bid_price() const {
 }
 
 std::optional<Qty> OrderBook::best_bid_quantity() const {
+    if (ladder_enabled_) {
+        long slot = highest_occupied(bid_occupancy_);
+        if (slot < 0) {
+            return std::nullopt;
+        }
+        return ladder_bid_levels_[static_cast<size_t>(slot)].total_quantity();
+    }
     if (buy_levels_.empty()) {
         return std::nullopt;
     }
@@ -193,6 +444,13 @@ std::optional<Qty> OrderBook::best_bid_quantity() const {
 }
 
 std::optional<Price> OrderBook::best_ask_price() const {
+    if (ladder_enabled_) {
+        long slot = lowest_occupied(ask_occupancy_);
+        if (slot < 0) {
+            return std::nullopt;
+        }
+        return ladder_low_ + static_cast<Price>(slot);
+    }
     if (sell_levels_.empty()) {
         return std::nullopt;
     }
@@ -200,6 +458,13 @@ std::optional<Price> OrderBook::best_ask_price() const {
 }
 
 std::optional<Qty> OrderBook::best_ask_quantity() const {
+    if (ladder_enabled_) {
+        long slot = lowest_occupied(ask_occupancy_);
+        if (slot < 0) {
+            return std::nullopt;
+        }
+        return ladder_ask_levels_[static_cast<size_t>(slot)].total_quantity();
+    }
     if (sell_levels_.empty()) {
         return std::nullopt;
     }
@@ -211,7 +476,7 @@ MarketSnapshot OrderBook::top_of_book(Timestamp timestamp) const {
     auto best_ask = best_ask_price();
     auto best_bid_qty = best_bid_quantity();
     auto best_ask_qty = best_ask_quantity();
-    
+
     return MarketSnapshot(
         best_bid.value_or(0),
         best_ask.value_or(0),
@@ -224,8 +489,35 @@ MarketSnapshot OrderBook::top_of_book(Timestamp timestamp) const {
 
 std::vector<PriceLevel> OrderBook::get_depth(int levels) const {
     std::vector<PriceLevel> depth;
-    depth.reserve(levels * 2); // Reserve for both sides
-    
+    depth.reserve(static_cast<size_t>(levels) * 2); // Reserve for both sides
+
+    if (ladder_enabled_) {
+        // Bid levels: walk downward from the best occupied slot
+        int found = 0;
+        long slot = highest_occupied(bid_occupancy_);
+        for (; slot >= 0 && found < levels; --slot) {
+            const auto& level = ladder_bid_levels_[static_cast<size_t>(slot)];
+            if (!level.empty()) {
+                depth.emplace_back(ladder_low_ + static_cast<Price>(slot), level.total_quantity(), 0);
+                found++;
+            }
+        }
+
+        // Ask levels: walk upward from the best occupied slot
+        found = 0;
+        slot = lowest_occupied(ask_occupancy_);
+        long n_slots = static_cast<long>(ladder_ask_levels_.size());
+        for (; slot >= 0 && slot < n_slots && found < levels; ++slot) {
+            const auto& level = ladder_ask_levels_[static_cast<size_t>(slot)];
+            if (!level.empty()) {
+                depth.emplace_back(ladder_low_ + static_cast<Price>(slot), 0, level.total_quantity());
+                found++;
+            }
+        }
+
+        return depth;
+    }
+
     // Add bid levels (descending price)
     auto buy_it = buy_levels_.begin();
     for (int i = 0; i < levels && buy_it != buy_levels_.end(); ++i, ++buy_it) {
@@ -233,7 +525,7 @@ std::vector<PriceLevel> OrderBook::get_depth(int levels) const {
         Qty qty = buy_it->second.total_quantity();
         depth.emplace_back(price, qty, 0);
     }
-    
+
     // Add ask levels (ascending price)
     auto sell_it = sell_levels_.begin();
     for (int i = 0; i < levels && sell_it != sell_levels_.end(); ++i, ++sell_it) {
@@ -241,50 +533,231 @@ std::vector<PriceLevel> OrderBook::get_depth(int levels) const {
         Qty qty = sell_it->second.total_quantity();
         depth.emplace_back(price, 0, qty);
     }
-    
+
     return depth;
 }
 
+void OrderBook::refresh_depth_cache() const {
+    bid_cache_count_ = 0;
+    ask_cache_count_ = 0;
+
+    if (ladder_enabled_) {
+        long slot = highest_occupied(bid_occupancy_);
+        for (; slot >= 0 && bid_cache_count_ < kDepthCacheLevels; --slot) {
+            const auto& level = ladder_bid_levels_[static_cast<size_t>(slot)];
+            if (!level.empty()) {
+                bid_cache_[static_cast<size_t>(bid_cache_count_++)] =
+                    PriceLevel(ladder_low_ + static_cast<Price>(slot), level.total_quantity(), 0);
+            }
+        }
+
+        slot = lowest_occupied(ask_occupancy_);
+        long n_slots = static_cast<long>(ladder_ask_levels_.size());
+        for (; slot >= 0 && slot < n_slots && ask_cache_count_ < kDepthCacheLevels; ++slot) {
+            const auto& level = ladder_ask_levels_[static_cast<size_t>(slot)];
+            if (!level.empty()) {
+                ask_cache_[static_cast<size_t>(ask_cache_count_++)] =
+                    PriceLevel(ladder_low_ + static_cast<Price>(slot), 0, level.total_quantity());
+            }
+        }
+    } else {
+        auto buy_it = buy_levels_.begin();
+        for (; bid_cache_count_ < kDepthCacheLevels && buy_it != buy_levels_.end(); ++buy_it) {
+            bid_cache_[static_cast<size_t>(bid_cache_count_++)] =
+                PriceLevel(buy_it->first, buy_it->second.total_quantity(), 0);
+        }
+
+        auto sell_it = sell_levels_.begin();
+        for (; ask_cache_count_ < kDepthCacheLevels && sell_it != sell_levels_.end(); ++sell_it) {
+            ask_cache_[static_cast<size_t>(ask_cache_count_++)] =
+                PriceLevel(sell_it->first, 0, sell_it->second.total_quantity());
+        }
+    }
+
+    cache_version_ = version_;
+}
+
+std::span<const PriceLevel> OrderBook::bid_depth() const {
+    if (cache_version_ != version_) {
+        refresh_depth_cache();
+    }
+    return {bid_cache_.data(), static_cast<size_t>(bid_cache_count_)};
+}
+
+std::span<const PriceLevel> OrderBook::ask_depth() const {
+    if (cache_version_ != version_) {
+        refresh_depth_cache();
+    }
+    return {ask_cache_.data(), static_cast<size_t>(ask_cache_count_)};
+}
+
 std::optional<Order> OrderBook::get_order(OrderId order_id) const {
     auto it = order_lookup_.find(order_id);
     if (it == order_lookup_.end()) {
         return std::nullopt;
     }
-    
-    Price price = it->second.first;
-    Side side = it->second.second;
-    
+    return node_pool_[it->second].order;
+}
+
+const OrderBookPriceLevel* OrderBook::find_level(Side side, Price price) const {
+    if (ladder_enabled_) {
+        if (!in_ladder_range(price)) {
+            return nullptr;
+        }
+        const auto& levels = side == Side::BUY ? ladder_bid_levels_ : ladder_ask_levels_;
+        const OrderBookPriceLevel& level = levels[ladder_index(price)];
+        return level.empty() ? nullptr : &level;
+    }
     if (side == Side::BUY) {
-        auto level_it = buy_levels_.find(price);
-        if (level_it != buy_levels_.end()) {
-            for (const auto& order : level_it->second.get_orders()) {
-                if (order.id == order_id) {
-                    return order;
-                }
+        auto it = buy_levels_.find(price);
+        return it == buy_levels_.end() ? nullptr : &it->second;
+    }
+    auto it = sell_levels_.find(price);
+    return it == sell_levels_.end() ? nullptr : &it->second;
+}
+
+std::optional<Qty> OrderBook::queue_position(OrderId order_id) const {
+    auto it = order_lookup_.find(order_id);
+    if (it == order_lookup_.end()) {
+        return std::nullopt;
+    }
+    const OrderNode& node = node_pool_[it->second];
+    const OrderBookPriceLevel* level = find_level(node.order.side, node.order.price);
+    if (level == nullptr) {
+        return std::nullopt;
+    }
+    return level->quantity_ahead(node.arrival);
+}
+
+double OrderBook::level_imbalance(Price price) const {
+    Qty bid_quantity = 0;
+    Qty ask_quantity = 0;
+    if (ladder_enabled_) {
+        const Price ladder_high = ladder_low_ + static_cast<Price>(ladder_bid_levels_.size());
+        if (price >= ladder_low_) {
+            long bid_index = price < ladder_high
+                                 ? highest_occupied(bid_occupancy_, ladder_index(price))
+                                 : highest_occupied(bid_occupancy_);
+            if (bid_index >= 0) {
+                bid_quantity = ladder_bid_levels_[static_cast<size_t>(bid_index)].total_quantity();
             }
         }
-    } else {
-        auto level_it = sell_levels_.find(price);
-        if (level_it != sell_levels_.end()) {
-            for (const auto& order : level_it->second.get_orders()) {
-                if (order.id == order_id) {
-                    return order;
-                }
+        if (price < ladder_high) {
+            long ask_index = price >= ladder_low_
+                                 ? lowest_occupied(ask_occupancy_, ladder_index(price))
+                                 : lowest_occupied(ask_occupancy_);
+            if (ask_index >= 0) {
+                ask_quantity = ladder_ask_levels_[static_cast<size_t>(ask_index)].total_quantity();
             }
         }
+    } else {
+        // buy_levels_ is ordered descending, so lower_bound lands on the
+        // first level at or below the price
+        auto bid_it = buy_levels_.lower_bound(price);
+        if (bid_it != buy_levels_.end()) {
+            bid_quantity = bid_it->second.total_quantity();
+        }
+        auto ask_it = sell_levels_.lower_bound(price);
+        if (ask_it != sell_levels_.end()) {
+            ask_quantity = ask_it->second.total_quantity();
+        }
     }
-    
-    return std::nullopt;
+    if (bid_quantity + ask_quantity == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(bid_quantity - ask_quantity) /
+           static_cast<double>(bid_quantity + ask_quantity);
+}
+
+void OrderBook::save_state(std::ostream& out) const {
+    checkpoint::write_pod(out, last_trade_price_);
+    checkpoint::write_pod(out, total_volume_);
+    checkpoint::write_pod(out, static_cast<uint64_t>(trade_count_));
+    checkpoint::write_pod(out, static_cast<uint64_t>(order_count_));
+
+    // Walk each side best-to-worst, FIFO within a level, writing the
+    // raw resting orders
+    auto write_level = [&](const OrderBookPriceLevel& level) {
+        for (OrderNodeIndex index = level.front(); index != kNullOrderNode;
+             index = node_pool_[index].next) {
+            checkpoint::write_pod(out, node_pool_[index].order);
+        }
+    };
+
+    if (ladder_enabled_) {
+        for (long slot = highest_occupied(bid_occupancy_); slot >= 0;
+             slot = (slot == 0 ? -1 : highest_occupied(bid_occupancy_, static_cast<size_t>(slot) - 1))) {
+            write_level(ladder_bid_levels_[static_cast<size_t>(slot)]);
+        }
+        long n_slots = static_cast<long>(ladder_ask_levels_.size());
+        for (long slot = lowest_occupied(ask_occupancy_); slot >= 0 && slot < n_slots;
+             slot = lowest_occupied(ask_occupancy_, static_cast<size_t>(slot) + 1)) {
+            write_level(ladder_ask_levels_[static_cast<size_t>(slot)]);
+        }
+    } else {
+        for (const auto& [price, level] : buy_levels_) {
+            write_level(level);
+        }
+        for (const auto& [price, level] : sell_levels_) {
+            write_level(level);
+        }
+    }
+}
+
+bool OrderBook::load_state(std::istream& in) {
+    Price last_trade_price = 0;
+    Qty total_volume = 0;
+    uint64_t trade_count = 0;
+    uint64_t order_count = 0;
+    if (!checkpoint::read_pod(in, last_trade_price) ||
+        !checkpoint::read_pod(in, total_volume) ||
+        !checkpoint::read_pod(in, trade_count) ||
+        !checkpoint::read_pod(in, order_count)) {
+        return false;
+    }
+
+    clear();
+
+    // Orders were written in FIFO order per level, so appending them to
+    // their sides reproduces queue priority exactly
+    for (uint64_t i = 0; i < order_count; ++i) {
+        Order order;
+        if (!checkpoint::read_pod(in, order)) {
+            return false;
+        }
+        add_limit_order_to_side(order);
+    }
+
+    last_trade_price_ = last_trade_price;
+    total_volume_ = total_volume;
+    trade_count_ = static_cast<size_t>(trade_count);
+    version_++;
+    return true;
 }
 
 void OrderBook::clear() {
     buy_levels_.clear();
     sell_levels_.clear();
+    if (ladder_enabled_) {
+        std::fill(ladder_bid_levels_.begin(), ladder_bid_levels_.end(), OrderBookPriceLevel());
+        std::fill(ladder_ask_levels_.begin(), ladder_ask_levels_.end(), OrderBookPriceLevel());
+        std::fill(bid_occupancy_.begin(), bid_occupancy_.end(), 0);
+        std::fill(ask_occupancy_.begin(), ask_occupancy_.end(), 0);
+    }
+    node_pool_.clear();
+    free_nodes_.clear();
     order_lookup_.clear();
     order_count_ = 0;
+    bid_order_count_ = 0;
+    ask_order_count_ = 0;
     last_trade_price_ = 0;
     total_volume_ = 0;
     trade_count_ = 0;
+    rejected_band_count_ = 0;
+    rejected_cap_count_ = 0;
+    expired_count_ = 0;
+    expired_order_ids_.clear();
+    version_++;
 }
 
 } // namespace mms
@@ -0,0 +1,284 @@
+#include "mms/simd_kernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define MMS_SIMD_X86 1
+#else
+#define MMS_SIMD_X86 0
+#endif
+
+namespace mms {
+namespace analysis {
+namespace simd {
+
+namespace {
+
+// Scalar reference implementations; also the tail handlers for the
+// vector paths
+double sum_scalar(const double* values, size_t n) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double sum_scalar(const int64_t* values, size_t n) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        total += static_cast<double>(values[i]);
+    }
+    return total;
+}
+
+double dot_scalar(const int64_t* a, const int64_t* b, size_t n) {
+    double total = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        total += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+    }
+    return total;
+}
+
+MinMax min_max_scalar(const int64_t* values, size_t n) {
+    MinMax result{values[0], values[0]};
+    for (size_t i = 1; i < n; ++i) {
+        if (values[i] < result.min) result.min = values[i];
+        if (values[i] > result.max) result.max = values[i];
+    }
+    return result;
+}
+
+MeanVariance mean_variance_scalar(const double* values, size_t n) {
+    double total = 0.0;
+    double total_sq = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        total += values[i];
+        total_sq += values[i] * values[i];
+    }
+    MeanVariance result;
+    result.mean = total / static_cast<double>(n);
+    result.variance = total_sq / static_cast<double>(n) - result.mean * result.mean;
+    if (result.variance < 0.0) result.variance = 0.0; // Rounding guard
+    return result;
+}
+
+MeanVariance mean_variance_scalar(const int64_t* values, size_t n) {
+    double total = 0.0;
+    double total_sq = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double v = static_cast<double>(values[i]);
+        total += v;
+        total_sq += v * v;
+    }
+    MeanVariance result;
+    result.mean = total / static_cast<double>(n);
+    result.variance = total_sq / static_cast<double>(n) - result.mean * result.mean;
+    if (result.variance < 0.0) result.variance = 0.0;
+    return result;
+}
+
+#if MMS_SIMD_X86
+
+bool detect_avx2() {
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+// Exact int64 -> double lane conversion for |x| < 2^51, via the
+// 2^52 + 2^51 magic-constant trick (vcvtqq2pd needs AVX-512)
+__attribute__((target("avx2,fma")))
+inline __m256d lanes_to_double(__m256i x) {
+    const __m256d magic = _mm256_set1_pd(0x0018000000000000); // 2^52 + 2^51
+    x = _mm256_add_epi64(x, _mm256_castpd_si256(magic));
+    return _mm256_sub_pd(_mm256_castsi256_pd(x), magic);
+}
+
+__attribute__((target("avx2,fma")))
+inline double horizontal_sum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(low) + _mm_cvtsd_f64(_mm_unpackhi_pd(low, low));
+}
+
+__attribute__((target("avx2,fma")))
+double sum_avx2(const double* values, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(values + i));
+    }
+    return horizontal_sum(acc) + sum_scalar(values + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+double sum_avx2(const int64_t* values, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        acc = _mm256_add_pd(acc, lanes_to_double(lanes));
+    }
+    return horizontal_sum(acc) + sum_scalar(values + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+double dot_avx2(const int64_t* a, const int64_t* b, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d va = lanes_to_double(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        __m256d vb = lanes_to_double(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        acc = _mm256_fmadd_pd(va, vb, acc);
+    }
+    return horizontal_sum(acc) + dot_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+MinMax min_max_avx2(const int64_t* values, size_t n) {
+    if (n < 4) {
+        return min_max_scalar(values, n);
+    }
+    // AVX2 has no packed epi64 min/max; compare-and-blend per lane
+    __m256i vmin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    __m256i vmax = vmin;
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        vmin = _mm256_blendv_epi8(vmin, lanes, _mm256_cmpgt_epi64(vmin, lanes));
+        vmax = _mm256_blendv_epi8(vmax, lanes, _mm256_cmpgt_epi64(lanes, vmax));
+    }
+    alignas(32) int64_t mins[4];
+    alignas(32) int64_t maxs[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+    MinMax result{mins[0], maxs[0]};
+    for (int lane = 1; lane < 4; ++lane) {
+        if (mins[lane] < result.min) result.min = mins[lane];
+        if (maxs[lane] > result.max) result.max = maxs[lane];
+    }
+    for (; i < n; ++i) {
+        if (values[i] < result.min) result.min = values[i];
+        if (values[i] > result.max) result.max = values[i];
+    }
+    return result;
+}
+
+__attribute__((target("avx2,fma")))
+MeanVariance mean_variance_avx2(const double* values, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    __m256d acc_sq = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d lanes = _mm256_loadu_pd(values + i);
+        acc = _mm256_add_pd(acc, lanes);
+        acc_sq = _mm256_fmadd_pd(lanes, lanes, acc_sq);
+    }
+    double total = horizontal_sum(acc);
+    double total_sq = horizontal_sum(acc_sq);
+    for (; i < n; ++i) {
+        total += values[i];
+        total_sq += values[i] * values[i];
+    }
+    MeanVariance result;
+    result.mean = total / static_cast<double>(n);
+    result.variance = total_sq / static_cast<double>(n) - result.mean * result.mean;
+    if (result.variance < 0.0) result.variance = 0.0;
+    return result;
+}
+
+__attribute__((target("avx2,fma")))
+MeanVariance mean_variance_avx2(const int64_t* values, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    __m256d acc_sq = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d lanes = lanes_to_double(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        acc = _mm256_add_pd(acc, lanes);
+        acc_sq = _mm256_fmadd_pd(lanes, lanes, acc_sq);
+    }
+    double total = horizontal_sum(acc);
+    double total_sq = horizontal_sum(acc_sq);
+    for (; i < n; ++i) {
+        double v = static_cast<double>(values[i]);
+        total += v;
+        total_sq += v * v;
+    }
+    MeanVariance result;
+    result.mean = total / static_cast<double>(n);
+    result.variance = total_sq / static_cast<double>(n) - result.mean * result.mean;
+    if (result.variance < 0.0) result.variance = 0.0;
+    return result;
+}
+
+const bool kHasAvx2 = detect_avx2();
+
+#endif // MMS_SIMD_X86
+
+} // namespace
+
+bool avx2_enabled() {
+#if MMS_SIMD_X86
+    return kHasAvx2;
+#else
+    return false;
+#endif
+}
+
+double sum(const double* values, size_t n) {
+#if MMS_SIMD_X86
+    if (kHasAvx2) {
+        return sum_avx2(values, n);
+    }
+#endif
+    return sum_scalar(values, n);
+}
+
+double sum(const int64_t* values, size_t n) {
+#if MMS_SIMD_X86
+    if (kHasAvx2) {
+        return sum_avx2(values, n);
+    }
+#endif
+    return sum_scalar(values, n);
+}
+
+double dot(const int64_t* a, const int64_t* b, size_t n) {
+#if MMS_SIMD_X86
+    if (kHasAvx2) {
+        return dot_avx2(a, b, n);
+    }
+#endif
+    return dot_scalar(a, b, n);
+}
+
+MinMax min_max(const int64_t* values, size_t n) {
+#if MMS_SIMD_X86
+    if (kHasAvx2) {
+        return min_max_avx2(values, n);
+    }
+#endif
+    return min_max_scalar(values, n);
+}
+
+MeanVariance mean_variance(const double* values, size_t n) {
+#if MMS_SIMD_X86
+    if (kHasAvx2) {
+        return mean_variance_avx2(values, n);
+    }
+#endif
+    return mean_variance_scalar(values, n);
+}
+
+MeanVariance mean_variance(const int64_t* values, size_t n) {
+#if MMS_SIMD_X86
+    if (kHasAvx2) {
+        return mean_variance_avx2(values, n);
+    }
+#endif
+    return mean_variance_scalar(values, n);
+}
+
+} // namespace simd
+} // namespace analysis
+} // namespace mms
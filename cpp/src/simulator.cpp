@@ -1,65 +1,467 @@
 #include "mms/simulator.hpp"
+#include "mms/spsc_ring.hpp"
+#include "mms/simd_kernels.hpp"
+#include "mms/checkpoint.hpp"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <sched.h>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <atomic>
 
 namespace mms {
 
+// Binary columnar format. Each file starts with a 16-byte header:
+//   magic "MMSC" | u32 version | u32 n_columns | u32 reserved
+// followed by one or more blocks:
+//   u64 n_rows | column 0 (n_rows x 8 bytes) | ... | column n-1
+// All columns are fixed-width 64-bit little-endian values (doubles are
+// stored as raw IEEE-754 bits), so a reader can map each column straight
+// into a NumPy array without parsing. One-shot saves write a single
+// block; streaming mode appends fixed-size blocks as data arrives. The
+// matching reader lives in python/mms/utils.py (read_columnar).
+namespace {
+
+constexpr char kColumnarMagic[4] = {'M', 'M', 'S', 'C'};
+constexpr uint32_t kColumnarVersion = 1;
+
+void write_columnar_header(std::ofstream& out, uint32_t n_columns) {
+    uint32_t reserved = 0;
+    out.write(kColumnarMagic, sizeof(kColumnarMagic));
+    out.write(reinterpret_cast<const char*>(&kColumnarVersion), sizeof(kColumnarVersion));
+    out.write(reinterpret_cast<const char*>(&n_columns), sizeof(n_columns));
+    out.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+}
+
+// With SoA storage a column is already a contiguous 64-bit array, so a
+// block write is one write() per column with no gather pass
+template <typename T>
+void write_column(std::ofstream& out, const std::vector<T>& column) {
+    static_assert(sizeof(T) == sizeof(int64_t));
+    out.write(reinterpret_cast<const char*>(column.data()),
+              static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+void write_trades_block(std::ofstream& out, const TradeColumns& trades) {
+    uint64_t n_rows = trades.size();
+    out.write(reinterpret_cast<const char*>(&n_rows), sizeof(n_rows));
+    write_column(out, trades.timestamp);
+    write_column(out, trades.maker_id);
+    write_column(out, trades.taker_id);
+    write_column(out, trades.price);
+    write_column(out, trades.quantity);
+}
+
+void write_snapshots_block(std::ofstream& out, const SnapshotColumns& snapshots) {
+    uint64_t n_rows = snapshots.size();
+    out.write(reinterpret_cast<const char*>(&n_rows), sizeof(n_rows));
+    write_column(out, snapshots.timestamp);
+    write_column(out, snapshots.best_bid);
+    write_column(out, snapshots.best_ask);
+    write_column(out, snapshots.best_bid_qty);
+    write_column(out, snapshots.best_ask_qty);
+    write_column(out, snapshots.last_trade_price);
+}
+
+void write_agent_pnl_block(std::ofstream& out, const AgentPnlColumns& rows) {
+    uint64_t n_rows = rows.size();
+    out.write(reinterpret_cast<const char*>(&n_rows), sizeof(n_rows));
+    write_column(out, rows.timestamp);
+    write_column(out, rows.agent_id);
+    write_column(out, rows.pnl);
+    write_column(out, rows.inventory);
+}
+
+// Chunked growth shared by all column structs: reserve exactly one more
+// chunk when full, instead of letting the vectors double
+template <typename... Columns>
+void grow_by_chunk(size_t size, Columns&... columns) {
+    size_t target = size + kColumnChunkRows;
+    (columns.reserve(target), ...);
+}
+
+} // namespace
+
+// Column struct implementations
+void TradeColumns::clear() {
+    timestamp.clear();
+    maker_id.clear();
+    taker_id.clear();
+    price.clear();
+    quantity.clear();
+}
+
+void TradeColumns::reserve(size_t n) {
+    timestamp.reserve(n);
+    maker_id.reserve(n);
+    taker_id.reserve(n);
+    price.reserve(n);
+    quantity.reserve(n);
+}
+
+void TradeColumns::push_back(const Trade& trade) {
+    if (timestamp.size() == timestamp.capacity()) {
+        grow_by_chunk(size(), timestamp, maker_id, taker_id, price, quantity);
+    }
+    timestamp.push_back(trade.timestamp);
+    maker_id.push_back(trade.maker_id);
+    taker_id.push_back(trade.taker_id);
+    price.push_back(trade.price);
+    quantity.push_back(trade.quantity);
+}
+
+void SnapshotColumns::clear() {
+    timestamp.clear();
+    best_bid.clear();
+    best_ask.clear();
+    best_bid_qty.clear();
+    best_ask_qty.clear();
+    last_trade_price.clear();
+}
+
+void SnapshotColumns::reserve(size_t n) {
+    timestamp.reserve(n);
+    best_bid.reserve(n);
+    best_ask.reserve(n);
+    best_bid_qty.reserve(n);
+    best_ask_qty.reserve(n);
+    last_trade_price.reserve(n);
+}
+
+void SnapshotColumns::push_back(const MarketSnapshot& snapshot) {
+    if (timestamp.size() == timestamp.capacity()) {
+        grow_by_chunk(size(), timestamp, best_bid, best_ask, best_bid_qty, best_ask_qty,
+                     last_trade_price);
+    }
+    timestamp.push_back(snapshot.timestamp);
+    best_bid.push_back(snapshot.best_bid);
+    best_ask.push_back(snapshot.best_ask);
+    best_bid_qty.push_back(snapshot.best_bid_qty);
+    best_ask_qty.push_back(snapshot.best_ask_qty);
+    last_trade_price.push_back(snapshot.last_trade_price);
+}
+
+void AgentPnlColumns::clear() {
+    agent_id.clear();
+    timestamp.clear();
+    pnl.clear();
+    inventory.clear();
+}
+
+void AgentPnlColumns::reserve(size_t n) {
+    agent_id.reserve(n);
+    timestamp.reserve(n);
+    pnl.reserve(n);
+    inventory.reserve(n);
+}
+
+void AgentPnlColumns::push_back(OrderId id, Timestamp time, double value, Qty position) {
+    if (agent_id.size() == agent_id.capacity()) {
+        grow_by_chunk(size(), agent_id, timestamp, pnl, inventory);
+    }
+    agent_id.push_back(id);
+    timestamp.push_back(time);
+    pnl.push_back(value);
+    inventory.push_back(position);
+}
+
+// StreamingAggregates implementation
+void StreamingAggregates::add_trade(const Trade& trade) {
+    trade_count++;
+    total_volume += trade.quantity;
+    price_volume_sum += static_cast<double>(trade.price) * static_cast<double>(trade.quantity);
+    volume_sum += static_cast<double>(trade.quantity);
+}
+
+void StreamingAggregates::add_snapshot(const MarketSnapshot& snapshot) {
+    snapshot_count++;
+
+    // Welford update over snapshot-to-snapshot log returns, mirroring
+    // calculate_price_volatility on the raw columns
+    if (snapshot.last_trade_price > 0) {
+        if (prev_last_trade > 0) {
+            double ret = std::log(static_cast<double>(snapshot.last_trade_price) /
+                                  static_cast<double>(prev_last_trade));
+            return_count++;
+            double delta = ret - return_mean;
+            return_mean += delta / static_cast<double>(return_count);
+            return_m2 += delta * (ret - return_mean);
+        }
+        prev_last_trade = snapshot.last_trade_price;
+    }
+
+    if (snapshot.best_bid > 0 && snapshot.best_ask > 0) {
+        Price spread = snapshot.best_ask - snapshot.best_bid;
+        spread_sum += static_cast<double>(spread);
+        spread_min = spread_count == 0 ? spread : std::min(spread_min, spread);
+        spread_max = std::max(spread_max, spread);
+        spread_count++;
+
+        size_t bucket = spread >= 0 && static_cast<size_t>(spread) < kSpreadBuckets
+                            ? static_cast<size_t>(spread)
+                            : kSpreadBuckets; // Overflow bucket
+        spread_histogram[bucket]++;
+    }
+}
+
+double StreamingAggregates::price_volatility() const {
+    if (return_count == 0) {
+        return 0.0;
+    }
+    return std::sqrt(return_m2 / static_cast<double>(return_count));
+}
+
+Price StreamingAggregates::spread_quantile(double fraction) const {
+    if (spread_count == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(spread_count));
+    if (target >= spread_count) {
+        target = spread_count - 1;
+    }
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < kSpreadBuckets; ++bucket) {
+        seen += spread_histogram[bucket];
+        if (seen > target) {
+            return static_cast<Price>(bucket);
+        }
+    }
+    return spread_max; // Quantile fell in the overflow bucket
+}
+
+void StreamingAggregates::clear() {
+    *this = StreamingAggregates{};
+}
+
 // MarketDataCollector implementation
+MarketDataCollector::~MarketDataCollector() {
+    finish_streaming();
+}
+
 void MarketDataCollector::record_trade(const Trade& trade) {
+    if (aggregating_) {
+        aggregates_.add_trade(trade);
+        // Algorithm R: keep a uniform sample of fixed size
+        uint64_t index = aggregates_.trade_count - 1;
+        if (trade_reservoir_.size() < reservoir_rows_) {
+            trade_reservoir_.push_back(trade);
+        } else {
+            uint64_t slot = reservoir_rng_.uniform_int<uint64_t>(0, index);
+            if (slot < reservoir_rows_) {
+                trade_reservoir_[slot] = trade;
+            }
+        }
+        return;
+    }
     trades_.push_back(trade);
+    if (streaming_ && trades_.size() >= block_rows_) {
+        flush_trades_block();
+    }
 }
 
 void MarketDataCollector::record_snapshot(const MarketSnapshot& snapshot) {
+    if (aggregating_) {
+        aggregates_.add_snapshot(snapshot);
+        uint64_t index = aggregates_.snapshot_count - 1;
+        if (snapshot_reservoir_.size() < reservoir_rows_) {
+            snapshot_reservoir_.push_back(snapshot);
+        } else {
+            uint64_t slot = reservoir_rng_.uniform_int<uint64_t>(0, index);
+            if (slot < reservoir_rows_) {
+                snapshot_reservoir_[slot] = snapshot;
+            }
+        }
+        return;
+    }
     snapshots_.push_back(snapshot);
+    if (streaming_ && snapshots_.size() >= block_rows_) {
+        flush_snapshots_block();
+    }
 }
 
 void MarketDataCollector::record_agent_pnl(OrderId agent_id, Timestamp timestamp, double pnl, Qty inventory) {
-    agent_pnl_.emplace_back(agent_id, timestamp, pnl, inventory);
+    if (aggregating_) {
+        // Keep only the latest row per agent so storage stays constant
+        // regardless of run length, like the trade and snapshot paths
+        auto [it, inserted] = agent_pnl_slots_.try_emplace(agent_id, agent_pnl_.size());
+        if (inserted) {
+            agent_pnl_.push_back(agent_id, timestamp, pnl, inventory);
+        } else {
+            size_t row = it->second;
+            agent_pnl_.timestamp[row] = timestamp;
+            agent_pnl_.pnl[row] = pnl;
+            agent_pnl_.inventory[row] = inventory;
+        }
+        return;
+    }
+    agent_pnl_.push_back(agent_id, timestamp, pnl, inventory);
+    if (streaming_ && agent_pnl_.size() >= block_rows_) {
+        flush_agent_pnl_block();
+    }
+}
+
+std::vector<Trade> MarketDataCollector::get_trades() const {
+    if (aggregating_) {
+        return trade_reservoir_;
+    }
+    std::vector<Trade> trades;
+    trades.reserve(trades_.size());
+    for (size_t i = 0; i < trades_.size(); ++i) {
+        trades.push_back(trades_.row(i));
+    }
+    return trades;
+}
+
+std::vector<MarketSnapshot> MarketDataCollector::get_snapshots() const {
+    if (aggregating_) {
+        return snapshot_reservoir_;
+    }
+    std::vector<MarketSnapshot> snapshots;
+    snapshots.reserve(snapshots_.size());
+    for (size_t i = 0; i < snapshots_.size(); ++i) {
+        snapshots.push_back(snapshots_.row(i));
+    }
+    return snapshots;
+}
+
+std::vector<std::tuple<OrderId, Timestamp, double, Qty>> MarketDataCollector::get_agent_pnl() const {
+    std::vector<std::tuple<OrderId, Timestamp, double, Qty>> rows;
+    rows.reserve(agent_pnl_.size());
+    for (size_t i = 0; i < agent_pnl_.size(); ++i) {
+        rows.emplace_back(agent_pnl_.agent_id[i], agent_pnl_.timestamp[i],
+                          agent_pnl_.pnl[i], agent_pnl_.inventory[i]);
+    }
+    return rows;
 }
 
 void MarketDataCollector::clear() {
     trades_.clear();
     snapshots_.clear();
     agent_pnl_.clear();
+    aggregates_.clear();
+    trade_reservoir_.clear();
+    snapshot_reservoir_.clear();
+    agent_pnl_slots_.clear();
 }
 
 void MarketDataCollector::save_to_csv(const std::string& output_dir) const {
     // Save trades
     std::ofstream trades_file(output_dir + "/trades.csv");
     trades_file << "timestamp,maker_id,taker_id,price,quantity\n";
-    for (const auto& trade : trades_) {
-        trades_file << trade.timestamp << "," << trade.maker_id << "," 
-                   << trade.taker_id << "," << trade.price << "," << trade.quantity << "\n";
+    for (size_t i = 0; i < trades_.size(); ++i) {
+        trades_file << trades_.timestamp[i] << "," << trades_.maker_id[i] << "," 
+                   << trades_.taker_id[i] << "," << trades_.price[i] << "," << trades_.quantity[i] << "\n";
     }
     trades_file.close();
     
     // Save market snapshots
     std::ofstream snapshots_file(output_dir + "/market_snapshots.csv");
     snapshots_file << "timestamp,best_bid,best_ask,best_bid_qty,best_ask_qty,last_trade_price\n";
-    for (const auto& snapshot : snapshots_) {
-        snapshots_file << snapshot.timestamp << "," << snapshot.best_bid << "," 
-                      << snapshot.best_ask << "," << snapshot.best_bid_qty << "," 
-                      << snapshot.best_ask_qty << "," << snapshot.last_trade_price << "\n";
+    for (size_t i = 0; i < snapshots_.size(); ++i) {
+        snapshots_file << snapshots_.timestamp[i] << "," << snapshots_.best_bid[i] << "," 
+                      << snapshots_.best_ask[i] << "," << snapshots_.best_bid_qty[i] << "," 
+                      << snapshots_.best_ask_qty[i] << "," << snapshots_.last_trade_price[i] << "\n";
     }
     snapshots_file.close();
     
     // Save agent PnL
     std::ofstream pnl_file(output_dir + "/agent_pnl.csv");
     pnl_file << "timestamp,agent_id,pnl,inventory\n";
-    for (const auto& pnl_record : agent_pnl_) {
-        pnl_file << std::get<1>(pnl_record) << "," << std::get<0>(pnl_record) << "," 
-                << std::get<2>(pnl_record) << "," << std::get<3>(pnl_record) << "\n";
+    for (size_t i = 0; i < agent_pnl_.size(); ++i) {
+        pnl_file << agent_pnl_.timestamp[i] << "," << agent_pnl_.agent_id[i] << "," 
+                << agent_pnl_.pnl[i] << "," << agent_pnl_.inventory[i] << "\n";
     }
     pnl_file.close();
 }
 
+void MarketDataCollector::save_to_binary(const std::string& output_dir) const {
+    std::ofstream trades_file(output_dir + "/trades.bin", std::ios::binary);
+    write_columnar_header(trades_file, 5);
+    write_trades_block(trades_file, trades_);
+
+    std::ofstream snapshots_file(output_dir + "/market_snapshots.bin", std::ios::binary);
+    write_columnar_header(snapshots_file, 6);
+    write_snapshots_block(snapshots_file, snapshots_);
+
+    std::ofstream pnl_file(output_dir + "/agent_pnl.bin", std::ios::binary);
+    write_columnar_header(pnl_file, 4);
+    write_agent_pnl_block(pnl_file, agent_pnl_);
+}
+
+void MarketDataCollector::enable_aggregation(size_t reservoir_rows, uint64_t seed) {
+    aggregating_ = true;
+    reservoir_rows_ = std::max<size_t>(1, reservoir_rows);
+    aggregates_.clear();
+    trade_reservoir_.clear();
+    trade_reservoir_.reserve(reservoir_rows_);
+    snapshot_reservoir_.clear();
+    snapshot_reservoir_.reserve(reservoir_rows_);
+    reservoir_rng_.seed(seed);
+}
+
+void MarketDataCollector::enable_streaming(const std::string& output_dir, size_t block_rows) {
+    finish_streaming();
+
+    block_rows_ = std::max<size_t>(1, block_rows);
+    trades_stream_.open(output_dir + "/trades.bin", std::ios::binary);
+    snapshots_stream_.open(output_dir + "/market_snapshots.bin", std::ios::binary);
+    agent_pnl_stream_.open(output_dir + "/agent_pnl.bin", std::ios::binary);
+    write_columnar_header(trades_stream_, 5);
+    write_columnar_header(snapshots_stream_, 6);
+    write_columnar_header(agent_pnl_stream_, 4);
+
+    trades_.reserve(block_rows_);
+    snapshots_.reserve(block_rows_);
+    agent_pnl_.reserve(block_rows_);
+    streaming_ = true;
+}
+
+void MarketDataCollector::finish_streaming() {
+    if (!streaming_) {
+        return;
+    }
+    if (!trades_.empty()) {
+        flush_trades_block();
+    }
+    if (!snapshots_.empty()) {
+        flush_snapshots_block();
+    }
+    if (!agent_pnl_.empty()) {
+        flush_agent_pnl_block();
+    }
+    trades_stream_.close();
+    snapshots_stream_.close();
+    agent_pnl_stream_.close();
+    streaming_ = false;
+}
+
+void MarketDataCollector::flush_trades_block() {
+    write_trades_block(trades_stream_, trades_);
+    trades_.clear();
+}
+
+void MarketDataCollector::flush_snapshots_block() {
+    write_snapshots_block(snapshots_stream_, snapshots_);
+    snapshots_.clear();
+}
+
+void MarketDataCollector::flush_agent_pnl_block() {
+    write_agent_pnl_block(agent_pnl_stream_, agent_pnl_);
+    agent_pnl_.clear();
+}
+
 // Simulator implementation
 Simulator::Simulator(const SimulationConfig& config)
-    : config_(config), rng_(config.seed), current_time_(config.start_time), 
-      current_step_(0), events_processed_(0) {
+    : config_(config), rng_(config.seed), arena_(config.memory),
+      current_time_(config.start_time), current_step_(0), events_processed_(0) {
+    // All hot-path trade/event buffers come out of the per-simulation
+    // arena, which is reset at the start of every step
+    matching_engine_.set_memory_resource(&arena_);
 }
 
 Simulator::RunResult Simulator::run(
@@ -69,14 +471,14 @@ Simulator::RunResult Simulator::run(
     const NoiseTrader::Config& noise_config
 ) {
     reset();
+    if (config_.aggregate_only) {
+        data_collector_.enable_aggregation(config_.reservoir_rows, config_.seed);
+    }
     initialize_agents(maker_config, taker_config, noise_config);
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    for (current_step_ = 0; current_step_ < n_steps; ++current_step_) {
-        process_simulation_step();
-        current_time_ += config_.time_step;
-    }
+    advance_simulation(n_steps);
     
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
@@ -94,10 +496,20 @@ Simulator::RunResult Simulator::run(
     result.total_trades = matching_engine_.trade_count();
     result.simulation_duration = current_time_ - config_.start_time;
     result.simulation_time_seconds = simulation_time_seconds;
+    result.latency_report = get_latency_report();
+    result.aggregates = data_collector_.aggregates();
+    result.memory_stats = get_memory_stats();
     
-    // Save data if output directory is specified
-    if (!config_.output_dir.empty()) {
-        data_collector_.save_to_csv(config_.output_dir);
+    // Save data if output directory is specified. In streaming mode the
+    // blocks have already gone to disk; just flush the tail.
+    if (data_collector_.streaming()) {
+        data_collector_.finish_streaming();
+    } else if (!config_.output_dir.empty()) {
+        if (config_.binary_output) {
+            data_collector_.save_to_binary(config_.output_dir);
+        } else {
+            data_collector_.save_to_csv(config_.output_dir);
+        }
     }
     
     return result;
@@ -105,6 +517,9 @@ Simulator::RunResult Simulator::run(
 
 Simulator::RunResult Simulator::run_with_agents(size_t n_steps, std::vector<std::unique_ptr<Agent>> agents) {
     reset();
+    if (config_.aggregate_only) {
+        data_collector_.enable_aggregation(config_.reservoir_rows, config_.seed);
+    }
     
     // Add custom agents
     for (auto& agent : agents) {
@@ -113,10 +528,35 @@ Simulator::RunResult Simulator::run_with_agents(size_t n_steps, std::vector<std:
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    for (current_step_ = 0; current_step_ < n_steps; ++current_step_) {
-        process_simulation_step();
-        current_time_ += config_.time_step;
-    }
+    advance_simulation(n_steps);
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    double simulation_time_seconds = duration.count() / 1e6;
+    
+    // Collect final data
+    collect_market_data();
+    collect_agent_data();
+    
+    RunResult result;
+    result.trades = data_collector_.get_trades();
+    result.market_snapshots = data_collector_.get_snapshots();
+    result.agent_pnl = data_collector_.get_agent_pnl();
+    result.total_events_processed = events_processed_;
+    result.total_trades = matching_engine_.trade_count();
+    result.simulation_duration = current_time_ - config_.start_time;
+    result.simulation_time_seconds = simulation_time_seconds;
+    result.latency_report = get_latency_report();
+    result.aggregates = data_collector_.aggregates();
+    result.memory_stats = get_memory_stats();
+    
+    return result;
+}
+
+Simulator::RunResult Simulator::resume(size_t n_steps) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    advance_simulation(n_steps);
     
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
@@ -134,10 +574,88 @@ Simulator::RunResult Simulator::run_with_agents(size_t n_steps, std::vector<std:
     result.total_trades = matching_engine_.trade_count();
     result.simulation_duration = current_time_ - config_.start_time;
     result.simulation_time_seconds = simulation_time_seconds;
+    result.latency_report = get_latency_report();
+    result.aggregates = data_collector_.aggregates();
+    result.memory_stats = get_memory_stats();
     
     return result;
 }
 
+bool Simulator::save_checkpoint(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    return save_checkpoint(out);
+}
+
+bool Simulator::restore_checkpoint(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    return restore_checkpoint(in);
+}
+
+bool Simulator::save_checkpoint(std::ostream& out) const {
+    checkpoint::CheckpointHeader header;
+    std::memcpy(header.magic, checkpoint::kCheckpointMagic, sizeof(header.magic));
+    header.version = checkpoint::kCheckpointVersion;
+    checkpoint::write_pod(out, header);
+
+    checkpoint::write_pod(out, current_time_);
+    checkpoint::write_pod(out, static_cast<uint64_t>(current_step_));
+    checkpoint::write_pod(out, static_cast<uint64_t>(events_processed_));
+    checkpoint::write_pod(out, rng_.get_state());
+    matching_engine_.save_state(out);
+    agent_manager_.save_state(out);
+
+    return static_cast<bool>(out);
+}
+
+bool Simulator::restore_checkpoint(std::istream& in) {
+    checkpoint::CheckpointHeader header;
+    if (!checkpoint::read_pod(in, header) ||
+        std::memcmp(header.magic, checkpoint::kCheckpointMagic, sizeof(header.magic)) != 0 ||
+        header.version != checkpoint::kCheckpointVersion) {
+        return false;
+    }
+
+    uint64_t step = 0;
+    uint64_t events = 0;
+    RNG::State rng_state;
+    if (!checkpoint::read_pod(in, current_time_) ||
+        !checkpoint::read_pod(in, step) ||
+        !checkpoint::read_pod(in, events) ||
+        !checkpoint::read_pod(in, rng_state)) {
+        return false;
+    }
+    current_step_ = static_cast<size_t>(step);
+    events_processed_ = static_cast<size_t>(events);
+    rng_.set_state(rng_state);
+
+    if (!matching_engine_.load_state(in) || !agent_manager_.load_state(in)) {
+        return false;
+    }
+    last_collected_book_version_ = 0;
+    return true;
+}
+
+std::vector<instrumentation::LatencyStats> Simulator::get_latency_report() const {
+    auto report = matching_engine_.get_latency_report();
+    auto agent_report = agent_manager_.get_latency_report();
+    report.insert(report.end(), agent_report.begin(), agent_report.end());
+    return report;
+}
+
+MemoryStats Simulator::get_memory_stats() const {
+    MemoryStats stats;
+    stats.arena_bytes_reserved = arena_.bytes_reserved();
+    stats.arena_huge_bytes = arena_.huge_page_bytes();
+    stats.cpu = sched_getcpu();
+    return stats;
+}
+
 Simulator::SimulationStats Simulator::get_stats() const {
     SimulationStats stats;
     stats.total_events_processed = events_processed_;
@@ -149,17 +667,22 @@ Simulator::SimulationStats Simulator::get_stats() const {
     stats.price_volatility = calculate_price_volatility();
     stats.simulation_duration = current_time_ - config_.start_time;
     stats.events_per_second = events_processed_ / (stats.simulation_duration / 1e9);
+    const auto& book = matching_engine_.get_order_book();
+    stats.orders_rejected_band = book.rejected_band_count();
+    stats.orders_rejected_cap = book.rejected_cap_count();
+    stats.orders_expired = book.expired_count();
     
     return stats;
 }
 
 void Simulator::reset() {
     matching_engine_.clear();
-    agent_manager_.reset();
+    agent_manager_.clear();
     data_collector_.clear();
     current_time_ = config_.start_time;
     current_step_ = 0;
     events_processed_ = 0;
+    last_collected_book_version_ = 0;
     rng_.seed(config_.seed);
 }
 
@@ -181,17 +704,247 @@ void Simulator::initialize_agents(
     agent_manager_.add_agent(std::move(noise));
 }
 
-void Simulator::process_simulation_step() {
-    // Generate events from agents
-    auto events = agent_manager_.step(current_time_);
+void Simulator::advance_simulation(size_t n_steps) {
+    matching_engine_.set_self_trade_prevention(config_.self_trade_prevention);
+    matching_engine_.set_admission_config(config_.admission);
+
+    // Arm the network delay model from its own RNG stream; any events
+    // still in flight from a previous run are stale
+    network_.reset(config_.network, rng_);
+    pending_events_.clear();
+
+    // Route trade notifications to the two involved agents via the
+    // engine's open-order index instead of broadcasting to every agent.
+    // The pipelined loop applies notifications on the producer thread
+    // after its step barrier, so it keeps the broadcast path.
+    if (config_.pipelined) {
+        matching_engine_.set_routed_trade_callback(nullptr);
+    } else {
+        matching_engine_.set_routed_trade_callback(
+            [this](const Trade& trade, OrderId maker_agent, OrderId taker_agent) {
+                agent_manager_.notify_trade(trade, maker_agent, taker_agent);
+            });
+    }
+
+    if (config_.event_driven) {
+        // n_steps keeps its meaning as a simulated-time horizon: the
+        // scheduler runs until the time the fixed-step loop would reach
+        Timestamp end_time = config_.start_time +
+                             static_cast<Timestamp>(n_steps) * config_.time_step;
+        run_event_loop(end_time);
+        return;
+    }
+    
+    if (config_.pipelined) {
+        run_pipelined_loop(n_steps);
+        return;
+    }
+    
+    for (current_step_ = 0; current_step_ < n_steps; ++current_step_) {
+        process_simulation_step();
+        current_time_ += config_.time_step;
+    }
+}
+
+void Simulator::run_pipelined_loop(size_t n_steps) {
+    // Agent event generation (this thread) and matching (a worker
+    // thread) communicate through two SPSC rings: events flow forward,
+    // trades flow back. A barrier at the end of every step waits until
+    // the matcher has drained the step's events before trade
+    // notifications are applied, so agents observe exactly the same
+    // event/trade interleaving as the sequential loop and runs stay
+    // bit-identical for a given seed.
+    SPSCRing<Event> event_ring(4096);
+    SPSCRing<Trade> trade_ring(4096);
+    std::atomic<size_t> consumed_events{0};
+    std::atomic<bool> done{false};
+    
+    std::thread matcher([&]() {
+        Event event;
+        TradeList trades;
+        VectorTradeSink sink(trades);
+        while (true) {
+            if (event_ring.try_pop(event)) {
+                trades.clear();
+                matching_engine_.process_events(std::span<const Event>(&event, 1), sink);
+                for (const auto& trade : trades) {
+                    while (!trade_ring.try_push(trade)) {
+                        std::this_thread::yield();
+                    }
+                }
+                consumed_events.fetch_add(1, std::memory_order_release);
+            } else if (done.load(std::memory_order_acquire)) {
+                break;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    size_t produced_events = 0;
+    for (current_step_ = 0; current_step_ < n_steps; ++current_step_) {
+        auto events = agent_manager_.step(current_time_);
+        for (const auto& event : events) {
+            while (!event_ring.try_push(event)) {
+                std::this_thread::yield();
+            }
+        }
+        produced_events += events.size();
+        events_processed_ += events.size();
+        
+        // Step barrier: once the matcher has consumed every event we
+        // produced, all of this step's trades are in the return ring
+        while (consumed_events.load(std::memory_order_acquire) < produced_events) {
+            std::this_thread::yield();
+        }
+
+        // The matcher is idle and its per-event trade lists are gone,
+        // so the step's arena allocations can be recycled race-free,
+        // matching the sequential loops' per-step arena lifetime
+        arena_.reset();
+
+        Trade trade;
+        while (trade_ring.try_pop(trade)) {
+            agent_manager_.notify_trade(trade);
+            if (data_collection_enabled_) {
+                data_collector_.record_trade(trade);
+            }
+        }
+        
+        // The matcher is idle at the barrier, so reading engine state
+        // for snapshots is race-free here
+        if (current_step_ % 100 == 0) {
+            collect_market_data();
+        }
+        if (current_step_ % 1000 == 0) {
+            collect_agent_data();
+        }
+        
+        current_time_ += config_.time_step;
+    }
+    
+    done.store(true, std::memory_order_release);
+    matcher.join();
+}
+
+void Simulator::run_event_loop(Timestamp end_time) {
+    // Min-heap of (wakeup time, agent index). Ties resolve by agent
+    // insertion order, so runs are deterministic for a given seed.
+    using Wakeup = std::pair<Timestamp, size_t>;
+    std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<Wakeup>> wakeups;
+    
+    const auto& agents = agent_manager_.get_agents();
+    for (size_t i = 0; i < agents.size(); ++i) {
+        wakeups.emplace(current_time_, i);
+    }
+    
+    constexpr Timestamp kNever = std::numeric_limits<Timestamp>::max();
+    while (true) {
+        // The next thing to happen is either an agent wakeup or an
+        // in-flight event arriving at the exchange; deliveries win ties
+        // so an order already on the wire lands before new decisions
+        Timestamp next_wakeup = wakeups.empty() ? kNever : wakeups.top().first;
+        Timestamp next_delivery = pending_events_.empty() ? kNever : pending_events_.next_time();
+        Timestamp next_time = std::min(next_wakeup, next_delivery);
+        if (next_time > end_time || next_time == kNever) {
+            break;
+        }
+        current_time_ = next_time;
+
+        if (next_delivery <= next_wakeup) {
+            arena_.reset();
+            deliver_network_events(current_time_);
+            continue;
+        }
+
+        auto [wakeup_time, agent_index] = wakeups.top();
+        wakeups.pop();
+        process_agent_wakeup(*agents[agent_index]);
+        
+        // Re-arm the agent. A wakeup at or before the current time means
+        // the agent has no scheduled event, so re-poll it one time step
+        // out to guarantee forward progress.
+        Timestamp next_agent_time = agents[agent_index]->next_event_time(current_time_);
+        if (next_agent_time <= current_time_) {
+            next_agent_time = current_time_ + config_.time_step;
+        }
+        wakeups.emplace(next_agent_time, agent_index);
+        
+        ++current_step_;
+        if (current_step_ % 100 == 0) {
+            collect_market_data();
+        }
+        if (current_step_ % 1000 == 0) {
+            collect_agent_data();
+        }
+    }
+    
+    // Events still in flight past the horizon are dropped with it
+    current_time_ = end_time;
+}
+
+void Simulator::process_agent_wakeup(Agent& agent) {
+    // Same pipeline as process_simulation_step, but for a single agent's
+    // events at its own wakeup time
+    arena_.reset();
+    
+    auto events = agent.step(current_time_);
+
+    // With the network layer on, events go onto the wire instead of
+    // straight into the engine; they are counted when they arrive
+    if (network_.enabled()) {
+        for (const auto& event : events) {
+            pending_events_.push(event, current_time_ + network_.sample_delay(event.agent_id));
+        }
+        return;
+    }
     
-    // Process events through matching engine
-    auto trades = matching_engine_.process_events(events);
+    TradeList trades(&arena_);
+    VectorTradeSink sink(trades);
+    matching_engine_.process_events(std::span<const Event>(events.data(), events.size()), sink);
     events_processed_ += events.size();
     
-    // Notify agents of trades
     for (const auto& trade : trades) {
-        agent_manager_.notify_trade(trade);
+        if (data_collection_enabled_) {
+            data_collector_.record_trade(trade);
+        }
+    }
+}
+
+void Simulator::process_simulation_step() {
+    // Rewind the arena; buffers from the previous step are dead by now
+    arena_.reset();
+
+    // Generate events from agents into an arena-backed buffer
+    std::pmr::vector<Event> events(&arena_);
+    if (config_.agent_threads > 1) {
+        agent_manager_.step_parallel(current_time_, events, config_.agent_threads);
+    } else {
+        agent_manager_.step(current_time_, events);
+    }
+    
+    if (network_.enabled()) {
+        // Events ride the wire and are matched once their delay elapses;
+        // anything due by the current step time arrives this step
+        for (const auto& event : events) {
+            pending_events_.push(event, current_time_ + network_.sample_delay(event.agent_id));
+        }
+        deliver_network_events(current_time_);
+    } else {
+        // Batch-process events through the matching engine, collecting
+        // trades into an arena-backed buffer via the sink API
+        TradeList trades(&arena_);
+        VectorTradeSink sink(trades);
+        matching_engine_.process_events(std::span<const Event>(events.data(), events.size()), sink);
+        events_processed_ += events.size();
+        
+        // Record trades; agents were already notified through the engine's
+        // routed trade callback as each event was matched
+        for (const auto& trade : trades) {
+            if (data_collection_enabled_) {
+                data_collector_.record_trade(trade);
+            }
+        }
     }
     
     // Collect data periodically
@@ -204,8 +957,31 @@ void Simulator::process_simulation_step() {
     }
 }
 
+void Simulator::deliver_network_events(Timestamp up_to) {
+    TradeList trades(&arena_);
+    VectorTradeSink sink(trades);
+    Event event;
+    while (pending_events_.pop_due(up_to, event)) {
+        matching_engine_.process_event(event, sink);
+        ++events_processed_;
+    }
+    for (const auto& trade : trades) {
+        if (data_collection_enabled_) {
+            data_collector_.record_trade(trade);
+        }
+    }
+}
+
 void Simulator::collect_market_data() {
     if (data_collection_enabled_) {
+        // Dirty check: if nothing has touched the book since the last
+        // snapshot, recording another identical row is pure overhead
+        uint64_t book_version = matching_engine_.get_order_book().version();
+        if (book_version == last_collected_book_version_) {
+            return;
+        }
+        last_collected_book_version_ = book_version;
+        
         auto snapshot = matching_engine_.get_market_snapshot(current_time_);
         data_collector_.record_snapshot(snapshot);
     }
@@ -221,34 +997,43 @@ void Simulator::collect_agent_data() {
 }
 
 double Simulator::calculate_average_spread() const {
-    const auto& snapshots = data_collector_.get_snapshots();
+    if (data_collector_.aggregating()) {
+        return data_collector_.aggregates().average_spread();
+    }
+    const auto& snapshots = data_collector_.snapshot_columns();
     if (snapshots.empty()) {
         return 0.0;
     }
     
-    double total_spread = 0.0;
-    int valid_spreads = 0;
-    
-    for (const auto& snapshot : snapshots) {
-        if (snapshot.best_bid > 0 && snapshot.best_ask > 0) {
-            total_spread += (snapshot.best_ask - snapshot.best_bid);
-            valid_spreads++;
+    std::vector<Price> spreads;
+    spreads.reserve(snapshots.size());
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        if (snapshots.best_bid[i] > 0 && snapshots.best_ask[i] > 0) {
+            spreads.push_back(snapshots.best_ask[i] - snapshots.best_bid[i]);
         }
     }
     
-    return valid_spreads > 0 ? total_spread / valid_spreads : 0.0;
+    if (spreads.empty()) {
+        return 0.0;
+    }
+    return analysis::simd::sum(spreads.data(), spreads.size()) /
+           static_cast<double>(spreads.size());
 }
 
 double Simulator::calculate_price_volatility() const {
-    const auto& snapshots = data_collector_.get_snapshots();
+    if (data_collector_.aggregating()) {
+        return data_collector_.aggregates().price_volatility();
+    }
+    const auto& snapshots = data_collector_.snapshot_columns();
     if (snapshots.size() < 2) {
         return 0.0;
     }
     
     std::vector<double> returns;
     for (size_t i = 1; i < snapshots.size(); ++i) {
-        if (snapshots[i].last_trade_price > 0 && snapshots[i-1].last_trade_price > 0) {
-            double ret = std::log(snapshots[i].last_trade_price / snapshots[i-1].last_trade_price);
+        if (snapshots.last_trade_price[i] > 0 && snapshots.last_trade_price[i-1] > 0) {
+            double ret = std::log(static_cast<double>(snapshots.last_trade_price[i]) /
+                                  static_cast<double>(snapshots.last_trade_price[i-1]));
             returns.push_back(ret);
         }
     }
@@ -257,20 +1042,7 @@ double Simulator::calculate_price_volatility() const {
         return 0.0;
     }
     
-    // Calculate standard deviation of returns
-    double mean = 0.0;
-    for (double ret : returns) {
-        mean += ret;
-    }
-    mean /= returns.size();
-    
-    double variance = 0.0;
-    for (double ret : returns) {
-        variance += (ret - mean) * (ret - mean);
-    }
-    variance /= returns.size();
-    
-    return std::sqrt(variance);
+    return std::sqrt(analysis::simd::mean_variance(returns.data(), returns.size()).variance);
 }
 
 // Analysis utility functions
@@ -292,25 +1064,58 @@ double calculate_vwap(const std::vector<Trade>& trades) {
     return total_quantity > 0 ? total_value / total_quantity : 0.0;
 }
 
+double calculate_vwap(const TradeColumns& trades) {
+    if (trades.empty()) {
+        return 0.0;
+    }
+    
+    // Two wide-register reductions over the price and quantity columns
+    double total_value = simd::dot(trades.price.data(), trades.quantity.data(), trades.size());
+    double total_quantity = simd::sum(trades.quantity.data(), trades.size());
+    
+    return total_quantity > 0 ? total_value / total_quantity : 0.0;
+}
+
 double calculate_twap(const std::vector<MarketSnapshot>& snapshots) {
     if (snapshots.empty()) {
         return 0.0;
     }
-    
+
+    // Same definition as the columnar overload below: exact double mid,
+    // counting only two-sided books, so both entry points agree on the
+    // same data
     double total_price = 0.0;
     int valid_prices = 0;
-    
+
     for (const auto& snapshot : snapshots) {
-        Price mid_price = get_mid_price(snapshot.best_bid, snapshot.best_ask);
-        if (mid_price > 0) {
-            total_price += mid_price;
+        if (snapshot.best_bid > 0 && snapshot.best_ask > 0) {
+            total_price += static_cast<double>(snapshot.best_bid + snapshot.best_ask) * 0.5;
             valid_prices++;
         }
     }
-    
+
     return valid_prices > 0 ? total_price / valid_prices : 0.0;
 }
 
+double calculate_twap(const SnapshotColumns& snapshots) {
+    if (snapshots.empty()) {
+        return 0.0;
+    }
+    
+    const size_t n = snapshots.size();
+    double total_price = 0.0;
+    double valid_prices = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        // Branch-free accumulation: invalid rows contribute zero weight
+        double valid = (snapshots.best_bid[i] > 0 && snapshots.best_ask[i] > 0) ? 1.0 : 0.0;
+        double mid = static_cast<double>(snapshots.best_bid[i] + snapshots.best_ask[i]) * 0.5;
+        total_price += valid * mid;
+        valid_prices += valid;
+    }
+    
+    return valid_prices > 0.0 ? total_price / valid_prices : 0.0;
+}
+
 double calculate_realized_volatility(const std::vector<MarketSnapshot>& snapshots) {
     if (snapshots.size() < 2) {
         return 0.0;
@@ -346,6 +1151,31 @@ double calculate_realized_volatility(const std::vector<MarketSnapshot>& snapshot
     return std::sqrt(variance);
 }
 
+double calculate_realized_volatility(const SnapshotColumns& snapshots) {
+    if (snapshots.size() < 2) {
+        return 0.0;
+    }
+    
+    // Two passes over the mid-price column (mean of log-returns, then
+    // variance), both plain strided loops
+    const size_t n = snapshots.size();
+    std::vector<double> returns;
+    returns.reserve(n - 1);
+    for (size_t i = 1; i < n; ++i) {
+        Price mid_prev = get_mid_price(snapshots.best_bid[i-1], snapshots.best_ask[i-1]);
+        Price mid_curr = get_mid_price(snapshots.best_bid[i], snapshots.best_ask[i]);
+        if (mid_prev > 0 && mid_curr > 0) {
+            returns.push_back(std::log(static_cast<double>(mid_curr) / static_cast<double>(mid_prev)));
+        }
+    }
+    
+    if (returns.empty()) {
+        return 0.0;
+    }
+    
+    return std::sqrt(simd::mean_variance(returns.data(), returns.size()).variance);
+}
+
 SpreadStats calculate_spread_stats(const std::vector<MarketSnapshot>& snapshots) {
     SpreadStats stats = {};
     
@@ -385,6 +1215,41 @@ SpreadStats calculate_spread_stats(const std::vector<MarketSnapshot>& snapshots)
     return stats;
 }
 
+SpreadStats calculate_spread_stats(const SnapshotColumns& snapshots) {
+    SpreadStats stats = {};
+    
+    if (snapshots.empty()) {
+        return stats;
+    }
+    
+    // Compact valid spreads into one contiguous buffer, then reduce it
+    // with the SIMD kernels (min/max and mean/variance in one pass each)
+    std::vector<Price> spreads;
+    spreads.reserve(snapshots.size());
+    for (size_t i = 0; i < snapshots.size(); ++i) {
+        if (snapshots.best_bid[i] > 0 && snapshots.best_ask[i] > 0) {
+            spreads.push_back(snapshots.best_ask[i] - snapshots.best_bid[i]);
+        }
+    }
+    
+    if (spreads.empty()) {
+        return stats;
+    }
+    
+    auto min_max = simd::min_max(spreads.data(), spreads.size());
+    auto moments = simd::mean_variance(spreads.data(), spreads.size());
+    stats.min_spread = static_cast<double>(min_max.min);
+    stats.max_spread = static_cast<double>(min_max.max);
+    stats.mean_spread = moments.mean;
+    stats.spread_volatility = std::sqrt(moments.variance);
+    
+    auto median_it = spreads.begin() + static_cast<std::ptrdiff_t>(spreads.size() / 2);
+    std::nth_element(spreads.begin(), median_it, spreads.end());
+    stats.median_spread = static_cast<double>(*median_it);
+    
+    return stats;
+}
+
 std::vector<AgentPerformance> calculate_agent_performance(
     const std::vector<std::tuple<OrderId, Timestamp, double, Qty>>& agent_pnl,
     const std::vector<Trade>& trades
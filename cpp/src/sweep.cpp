@@ -0,0 +1,124 @@
+#include "mms/sweep.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace mms {
+
+SweepRunner::SweepRunner(const SweepConfig& config) : config_(config) {
+    size_t hw = std::thread::hardware_concurrency();
+    if (hw == 0) {
+        hw = 1;
+    }
+    n_workers_ = config_.n_threads > 0 ? config_.n_threads : hw;
+    n_workers_ = std::min(n_workers_, std::max<size_t>(1, n_jobs()));
+}
+
+size_t SweepRunner::n_jobs() const {
+    size_t grid_size = config_.grid.empty() ? 1 : config_.grid.size();
+    return grid_size * config_.n_seeds;
+}
+
+SweepRunner::SweepResult SweepRunner::run(size_t n_steps) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const size_t total_jobs = n_jobs();
+    const AgentConfigPoint default_point;
+    std::vector<RunSummary> summaries(total_jobs);
+
+    // Workers pull job indices from a shared atomic ticket, so a worker
+    // that finishes early simply takes the next pending job; results are
+    // written by job index and never contended
+    std::atomic<size_t> next_job{0};
+
+    const bool pin_workers = config_.base.memory.pin_workers;
+    const size_t n_cpus = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    std::vector<std::thread> workers;
+    workers.reserve(n_workers_);
+    for (size_t w = 0; w < n_workers_; ++w) {
+        workers.emplace_back([this, n_steps, total_jobs, pin_workers, n_cpus, w,
+                              &default_point, &summaries, &next_job]() {
+            // Round-robin CPU pinning keeps each worker on one core for
+            // the whole sweep, so its simulator state stays in the local
+            // caches and, on multi-socket boxes, on the local NUMA node
+            if (pin_workers) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(static_cast<int>(w % n_cpus), &cpus);
+                pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            }
+
+            // One Simulator per worker, reused across its jobs; run()
+            // resets the engine, agents and RNG from the job's config.
+            // Constructed after pinning, so first-touch places the arena
+            // and book on the worker's node.
+            Simulator simulator(config_.base);
+
+            size_t job;
+            while ((job = next_job.fetch_add(1)) < total_jobs) {
+                size_t config_index = job / config_.n_seeds;
+                size_t seed_index = job % config_.n_seeds;
+                const AgentConfigPoint& point =
+                    config_.grid.empty() ? default_point : config_.grid[config_index];
+
+                SimulationConfig run_config = config_.base;
+                run_config.seed = config_.first_seed + seed_index;
+                run_config.output_dir.clear(); // No per-run file dumps
+                simulator.update_config(run_config);
+
+                auto result = simulator.run(n_steps, point.maker_config,
+                                            point.taker_config, point.noise_config);
+
+                RunSummary& summary = summaries[job];
+                summary.seed = run_config.seed;
+                summary.config_index = config_index;
+                summary.total_events_processed = result.total_events_processed;
+                summary.total_trades = result.total_trades;
+                summary.vwap = analysis::calculate_vwap(result.trades);
+                summary.simulation_time_seconds = result.simulation_time_seconds;
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    SweepResult result;
+    result.runs = std::move(summaries);
+    result.wall_time_seconds = static_cast<double>(duration.count()) / 1e6;
+
+    for (const auto& summary : result.runs) {
+        result.total_events_processed += summary.total_events_processed;
+        result.total_trades += summary.total_trades;
+    }
+
+    if (!result.runs.empty()) {
+        double n = static_cast<double>(result.runs.size());
+        result.mean_trades_per_run = static_cast<double>(result.total_trades) / n;
+        result.mean_events_per_run = static_cast<double>(result.total_events_processed) / n;
+
+        double trades_variance = 0.0;
+        double events_variance = 0.0;
+        for (const auto& summary : result.runs) {
+            double td = static_cast<double>(summary.total_trades) - result.mean_trades_per_run;
+            double ed = static_cast<double>(summary.total_events_processed) - result.mean_events_per_run;
+            trades_variance += td * td;
+            events_variance += ed * ed;
+        }
+        result.std_trades_per_run = std::sqrt(trades_variance / n);
+        result.std_events_per_run = std::sqrt(events_variance / n);
+    }
+
+    return result;
+}
+
+} // namespace mms
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "mms/arena.hpp"
+#include "mms/types.hpp"
+#include <memory_resource>
+#include <vector>
+
+namespace mms {
+
+class ArenaTest : public ::testing::Test {
+protected:
+    Arena arena;
+};
+
+TEST_F(ArenaTest, BasicAllocation) {
+    void* p1 = arena.allocate(64, 8);
+    void* p2 = arena.allocate(64, 8);
+
+    EXPECT_NE(p1, nullptr);
+    EXPECT_NE(p2, nullptr);
+    EXPECT_NE(p1, p2);
+    EXPECT_GE(arena.bytes_allocated(), 128u);
+    EXPECT_EQ(arena.block_count(), 1u);
+}
+
+TEST_F(ArenaTest, ResetKeepsBlocks) {
+    void* first = arena.allocate(1024, 8);
+    EXPECT_NE(first, nullptr);
+    size_t reserved = arena.bytes_reserved();
+    EXPECT_GT(reserved, 0u);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytes_allocated(), 0u);
+    EXPECT_EQ(arena.bytes_reserved(), reserved);
+
+    // Steady state: re-allocating after reset reuses the same block
+    void* p = arena.allocate(1024, 8);
+    EXPECT_NE(p, nullptr);
+    EXPECT_EQ(arena.bytes_reserved(), reserved);
+}
+
+TEST_F(ArenaTest, OversizedAllocationGetsDedicatedBlock) {
+    void* p = arena.allocate(4 * Arena::kDefaultBlockSize, 8);
+    EXPECT_NE(p, nullptr);
+    EXPECT_GE(arena.bytes_reserved(), 4 * Arena::kDefaultBlockSize);
+}
+
+TEST_F(ArenaTest, BacksPmrContainers) {
+    std::pmr::vector<Trade> trades(&arena);
+    for (int i = 0; i < 1000; ++i) {
+        trades.emplace_back(1, 2, 10000 + i, 10, 1000 + i);
+    }
+
+    EXPECT_EQ(trades.size(), 1000u);
+    EXPECT_EQ(trades[999].price, 10999);
+    EXPECT_GT(arena.bytes_allocated(), 0u);
+}
+
+TEST_F(ArenaTest, ReleaseFreesBlocks) {
+    void* p = arena.allocate(1024, 8);
+    EXPECT_NE(p, nullptr);
+    arena.release();
+    EXPECT_EQ(arena.bytes_reserved(), 0u);
+    EXPECT_EQ(arena.block_count(), 0u);
+}
+
+TEST_F(ArenaTest, TransparentHugePagesBackBlocks) {
+    MemoryConfig config;
+    config.huge_pages = HugePageMode::TRANSPARENT;
+    Arena huge_arena(config);
+
+    // Touch every page of a multi-megabyte allocation
+    const size_t size = 3 << 20;
+    auto* data = static_cast<std::byte*>(huge_arena.allocate(size, 64));
+    ASSERT_NE(data, nullptr);
+    for (size_t i = 0; i < size; i += 4096) {
+        data[i] = std::byte{0xAB};
+    }
+
+    // Blocks are rounded to the 2MB granule and counted as huge-backed
+    EXPECT_GE(huge_arena.huge_page_bytes(), size);
+    EXPECT_EQ(huge_arena.huge_page_bytes() % Arena::kHugePageSize, 0u);
+    EXPECT_EQ(huge_arena.huge_page_bytes(), huge_arena.bytes_reserved());
+
+    huge_arena.release();
+    EXPECT_EQ(huge_arena.huge_page_bytes(), 0u);
+}
+
+TEST_F(ArenaTest, ExplicitHugePagesFallBackWhenPoolIsEmpty) {
+    // MAP_HUGETLB needs a reserved pool; without one the arena must fall
+    // back to a transparent mapping rather than fail the allocation
+    MemoryConfig config;
+    config.huge_pages = HugePageMode::EXPLICIT;
+    Arena huge_arena(config);
+
+    void* data = huge_arena.allocate(1 << 20, 64);
+    EXPECT_NE(data, nullptr);
+    EXPECT_GT(huge_arena.huge_page_bytes(), 0u);
+}
+
+} // namespace mms
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "mms/event_journal.hpp"
+#include "mms/matching_engine.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace mms {
+
+class EventJournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (std::filesystem::temp_directory_path() / "mms_test_journal.bin").string();
+        std::remove(path_.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    std::string path_;
+};
+
+TEST_F(EventJournalTest, WriteAndReadBack) {
+    std::vector<Event> events = {
+        Event(EventType::LIMIT, 1, Side::BUY, 10000, 100, 1000, 1),
+        Event(EventType::LIMIT, 2, Side::SELL, 10002, 50, 1001, 2),
+        Event(EventType::MARKET, 3, Side::BUY, 0, 30, 1002, 3)
+    };
+
+    {
+        EventJournalWriter writer(path_);
+        ASSERT_TRUE(writer.is_open());
+        for (const auto& event : events) {
+            writer.append(event);
+        }
+        EXPECT_EQ(writer.count(), events.size());
+    }
+
+    EventJournalReader reader(path_);
+    ASSERT_TRUE(reader.is_open());
+    ASSERT_EQ(reader.count(), events.size());
+    auto mapped = reader.events();
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(mapped[i].type, events[i].type);
+        EXPECT_EQ(mapped[i].order_id, events[i].order_id);
+        EXPECT_EQ(mapped[i].price, events[i].price);
+        EXPECT_EQ(mapped[i].quantity, events[i].quantity);
+        EXPECT_EQ(mapped[i].timestamp, events[i].timestamp);
+    }
+}
+
+TEST_F(EventJournalTest, FileIsTrimmedOnClose) {
+    {
+        EventJournalWriter writer(path_);
+        ASSERT_TRUE(writer.is_open());
+        writer.append(Event(EventType::LIMIT, 1, Side::BUY, 10000, 100, 1000, 1));
+    }
+    EXPECT_EQ(std::filesystem::file_size(path_),
+              sizeof(EventJournalHeader) + sizeof(Event));
+}
+
+TEST_F(EventJournalTest, GrowsPastInitialCapacity) {
+    // Enough events to force at least one doubling remap of the 1 MiB
+    // initial mapping
+    const size_t n = 50000;
+    {
+        EventJournalWriter writer(path_);
+        ASSERT_TRUE(writer.is_open());
+        for (size_t i = 0; i < n; ++i) {
+            writer.append(Event(EventType::LIMIT, i + 1, Side::BUY,
+                                10000 + static_cast<Price>(i % 10), 10,
+                                1000 + static_cast<Timestamp>(i), 1));
+        }
+    }
+
+    EventJournalReader reader(path_);
+    ASSERT_TRUE(reader.is_open());
+    EXPECT_EQ(reader.count(), n);
+    EXPECT_EQ(reader.events().back().order_id, n);
+}
+
+TEST_F(EventJournalTest, EngineAppendsProcessedEvents) {
+    EventJournalWriter writer(path_);
+    ASSERT_TRUE(writer.is_open());
+
+    MatchingEngine engine;
+    engine.set_journal(&writer);
+    engine.process_event(Event(EventType::LIMIT, 1, Side::SELL, 10002, 50, 1000, 1));
+    engine.process_event(Event(EventType::MARKET, 2, Side::BUY, 0, 30, 1001, 2));
+    EXPECT_EQ(writer.count(), 2);
+
+    // Detaching stops capture
+    engine.set_journal(nullptr);
+    engine.process_event(Event(EventType::CANCEL, 1, Side::SELL, 0, 0, 1002, 1));
+    EXPECT_EQ(writer.count(), 2);
+}
+
+TEST_F(EventJournalTest, ReplayReproducesBookState) {
+    // Record a run through one engine
+    MatchingEngine recorded;
+    {
+        EventJournalWriter writer(path_);
+        ASSERT_TRUE(writer.is_open());
+        recorded.set_journal(&writer);
+        recorded.process_event(Event(EventType::LIMIT, 1, Side::BUY, 10000, 100, 1000, 1));
+        recorded.process_event(Event(EventType::LIMIT, 2, Side::SELL, 10002, 80, 1001, 2));
+        recorded.process_event(Event(EventType::MARKET, 3, Side::BUY, 0, 30, 1002, 3));
+        recorded.process_event(Event(EventType::CANCEL, 1, Side::BUY, 0, 0, 1003, 1));
+        recorded.set_journal(nullptr);
+    }
+
+    // Replay into a fresh engine and compare the end states
+    MatchingEngine replayed;
+    ReplayDriver driver(path_);
+    ASSERT_TRUE(driver.is_open());
+    auto result = driver.replay(replayed);
+
+    EXPECT_EQ(result.events_replayed, 4);
+    EXPECT_EQ(result.trades, 1);
+    EXPECT_EQ(replayed.order_count(), recorded.order_count());
+
+    const auto& recorded_book = recorded.get_order_book();
+    const auto& replayed_book = replayed.get_order_book();
+    EXPECT_EQ(replayed_book.trade_count(), recorded_book.trade_count());
+    EXPECT_EQ(replayed_book.total_volume(), recorded_book.total_volume());
+    EXPECT_EQ(replayed_book.last_trade_price(), recorded_book.last_trade_price());
+    EXPECT_EQ(replayed_book.best_bid_price(), recorded_book.best_bid_price());
+    EXPECT_EQ(replayed_book.best_ask_price(), recorded_book.best_ask_price());
+}
+
+TEST_F(EventJournalTest, ReaderRejectsCorruptFiles) {
+    EXPECT_FALSE(EventJournalReader(path_ + ".missing").is_open());
+
+    std::ofstream out(path_, std::ios::binary);
+    out << "not a journal";
+    out.close();
+    EXPECT_FALSE(EventJournalReader(path_).is_open());
+}
+
+} // namespace mms
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "mms/instrumentation.hpp"
+#include "mms/simulator.hpp"
+
+namespace mms {
+namespace instrumentation {
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 0; v < LatencyHistogram::kSubBuckets; ++v) {
+        EXPECT_EQ(LatencyHistogram::bucket_value(LatencyHistogram::bucket_index(v)), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketResolutionIsLogarithmic) {
+    // The bucket lower bound must be within one sub-bucket width
+    // (1/16th) of the recorded value at any magnitude
+    for (uint64_t v : {17ull, 100ull, 1000ull, 123456ull, 98765432101ull}) {
+        uint64_t lower = LatencyHistogram::bucket_value(LatencyHistogram::bucket_index(v));
+        EXPECT_LE(lower, v);
+        EXPECT_GT(lower + lower / LatencyHistogram::kSubBuckets + 1, v) << "v=" << v;
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesTrackDistribution) {
+    LatencyHistogram histogram;
+    // 1000 samples at 100ns, 10 outliers at ~100us
+    for (int i = 0; i < 1000; ++i) {
+        histogram.record(100);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(100000);
+    }
+
+    EXPECT_EQ(histogram.count(), 1010);
+    EXPECT_EQ(histogram.min(), 100);
+    EXPECT_EQ(histogram.max(), 100000);
+
+    auto stats = histogram.stats("test");
+    EXPECT_EQ(stats.p50_ns, LatencyHistogram::bucket_value(LatencyHistogram::bucket_index(100)));
+    EXPECT_EQ(stats.p99_ns, stats.p50_ns);
+    // p999 lands on the outliers
+    EXPECT_GE(stats.p999_ns, 90000u);
+}
+
+TEST(LatencyHistogramTest, MergeCombinesCountsAndExtremes) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(10);
+    a.record(20);
+    b.record(5);
+    b.record(1000);
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 4);
+    EXPECT_EQ(a.min(), 5);
+    EXPECT_EQ(a.max(), 1000);
+
+    a.clear();
+    EXPECT_EQ(a.count(), 0);
+    EXPECT_EQ(a.value_at_percentile(0.99), 0);
+}
+
+TEST(LatencyHistogramTest, TimerRecordsElapsedTime) {
+    LatencyHistogram histogram;
+    {
+        ScopedLatencyTimer timer(histogram);
+    }
+    EXPECT_EQ(histogram.count(), 1);
+}
+
+TEST(LatencyReportTest, ReportMatchesBuildConfiguration) {
+    SimulationConfig config;
+    config.seed = 42;
+    config.max_steps = 100;
+
+    Simulator simulator(config);
+    auto result = simulator.run(100);
+
+#if MMS_INSTRUMENTATION
+    // One row per matching path plus the agent step timer
+    ASSERT_EQ(result.latency_report.size(), 4);
+    EXPECT_EQ(result.latency_report[0].name, "process_limit_order");
+    EXPECT_GT(result.latency_report[0].count, 0u);
+    EXPECT_EQ(result.latency_report[3].name, "agent_step");
+#else
+    EXPECT_TRUE(result.latency_report.empty());
+#endif
+}
+
+} // namespace instrumentation
+} // namespace mms
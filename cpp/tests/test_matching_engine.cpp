@@ -67,6 +67,26 @@ TEST_F(MatchingEngineTest, ProcessMultipleEvents) {
     EXPECT_EQ(engine.order_count(), 2); // 1 buy + 1 sell remaining
 }
 
+TEST_F(MatchingEngineTest, ProcessEventsWithTradeSink) {
+    std::vector<Event> events = {
+        Event(EventType::LIMIT, 1, Side::SELL, 10002, 50, 1000, 1),
+        Event(EventType::MARKET, 2, Side::BUY, 0, 30, 1001, 2)
+    };
+
+    TradeList trades;
+    VectorTradeSink sink(trades);
+    engine.process_events(std::span<const Event>(events.data(), events.size()), sink);
+
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].price, 10002);
+    EXPECT_EQ(trades[0].quantity, 30);
+
+    // The sink appends; a second batch must not clear prior trades
+    Event more(EventType::MARKET, 3, Side::BUY, 0, 10, 1002, 3);
+    engine.process_event(more, sink);
+    EXPECT_EQ(trades.size(), 2);
+}
+
 TEST_F(MatchingEngineTest, CrossOrderExecution) {
     // Add a sell order
     Event sell_event(EventType::LIMIT, 1, Side::SELL, 10000, 100, 1000, 1);
@@ -166,4 +186,190 @@ TEST_F(MatchingEngineTest, ClearEngine) {
     EXPECT_EQ(engine.trade_count(), 0);
 }
 
+TEST_F(MatchingEngineTest, SelfTradePreventionSkipsOwnOrders) {
+    engine.set_self_trade_prevention(true);
+
+    // Agent 1 rests an ask, then sends a crossing buy; STP must skip its
+    // own quote and leave both orders resting (no cancels, no fill)
+    engine.process_event(Event(EventType::LIMIT, 1, Side::SELL, 10002, 50, 1000, 1));
+    auto trades = engine.process_event(Event(EventType::LIMIT, 2, Side::BUY, 10002, 30, 1001, 1));
+
+    EXPECT_EQ(trades.size(), 0);
+    EXPECT_EQ(engine.order_count(), 2);
+    EXPECT_TRUE(engine.get_order_book().get_order(1).has_value());
+
+    // A different agent still matches against the resting ask
+    trades = engine.process_event(Event(EventType::MARKET, 3, Side::BUY, 0, 20, 1002, 2));
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].maker_id, 1);
+}
+
+TEST_F(MatchingEngineTest, SelfTradePreventionMatchesDeeperLevels) {
+    engine.set_self_trade_prevention(true);
+
+    // Agent 1's ask is at the front of the best level; agent 2's sits
+    // behind it and one level up
+    engine.process_event(Event(EventType::LIMIT, 1, Side::SELL, 10002, 50, 1000, 1));
+    engine.process_event(Event(EventType::LIMIT, 2, Side::SELL, 10002, 40, 1001, 2));
+    engine.process_event(Event(EventType::LIMIT, 3, Side::SELL, 10003, 40, 1002, 2));
+
+    // Agent 1 lifts: its own order is skipped, the rest fill in order
+    auto trades = engine.process_event(Event(EventType::MARKET, 4, Side::BUY, 0, 60, 1003, 1));
+
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[0].maker_id, 2);
+    EXPECT_EQ(trades[0].quantity, 40);
+    EXPECT_EQ(trades[1].maker_id, 3);
+    EXPECT_EQ(trades[1].quantity, 20);
+    EXPECT_TRUE(engine.get_order_book().get_order(1).has_value());
+}
+
+TEST_F(MatchingEngineTest, OpenOrderIndexTracksRestingOrders) {
+    engine.process_event(Event(EventType::LIMIT, 1, Side::BUY, 10000, 100, 1000, 7));
+    engine.process_event(Event(EventType::LIMIT, 2, Side::SELL, 10005, 50, 1001, 7));
+
+    EXPECT_EQ(engine.open_order_count(7), 2);
+    EXPECT_EQ(engine.agent_of(1), 7);
+
+    // Cancel drops the order from the index
+    engine.process_event(Event(EventType::CANCEL, 1, Side::BUY, 0, 0, 1002, 7));
+    EXPECT_EQ(engine.open_order_count(7), 1);
+    EXPECT_FALSE(engine.agent_of(1).has_value());
+
+    // A full fill drops it too
+    engine.process_event(Event(EventType::MARKET, 3, Side::BUY, 0, 50, 1003, 8));
+    EXPECT_EQ(engine.open_order_count(7), 0);
+}
+
+TEST_F(MatchingEngineTest, RoutedTradeCallbackCarriesBothAgents) {
+    OrderId seen_maker = 0;
+    OrderId seen_taker = 0;
+    engine.set_routed_trade_callback(
+        [&](const Trade&, OrderId maker_agent, OrderId taker_agent) {
+            seen_maker = maker_agent;
+            seen_taker = taker_agent;
+        });
+
+    engine.process_event(Event(EventType::LIMIT, 1, Side::SELL, 10002, 50, 1000, 7));
+    engine.process_event(Event(EventType::MARKET, 2, Side::BUY, 0, 50, 1001, 8));
+
+    EXPECT_EQ(seen_maker, 7);
+    EXPECT_EQ(seen_taker, 8);
+}
+
+TEST_F(MatchingEngineTest, FeedPublishesAddExecuteDelete) {
+    FeedPublisher feed(64);
+    engine.set_feed_publisher(&feed);
+
+    // Resting ask -> ADD
+    engine.process_event(Event(EventType::LIMIT, 1, Side::SELL, 101, 100, 1000, 7));
+    // Crossing buy fills 60 and rests 0 -> EXECUTE only
+    engine.process_event(Event(EventType::LIMIT, 2, Side::BUY, 101, 60, 2500, 8));
+    // Cancel the remainder -> DELETE
+    engine.process_event(Event(EventType::CANCEL, 1, Side::SELL, 0, 0, 4000, 7));
+
+    FeedMessage message;
+    ASSERT_TRUE(feed.ring().try_pop(message));
+    EXPECT_EQ(message.sequence, 0u);
+    EXPECT_EQ(message.type, FeedMessageType::ADD);
+    EXPECT_EQ(message.order_id, 1u);
+    EXPECT_EQ(message.side, 1);
+    EXPECT_EQ(message.price, 101);
+    EXPECT_EQ(message.quantity, 100);
+    EXPECT_EQ(message.timestamp_delta, 1000u);
+
+    ASSERT_TRUE(feed.ring().try_pop(message));
+    EXPECT_EQ(message.sequence, 1u);
+    EXPECT_EQ(message.type, FeedMessageType::EXECUTE);
+    EXPECT_EQ(message.order_id, 1u); // Fill is reported against the maker
+    EXPECT_EQ(message.quantity, 60);
+    EXPECT_EQ(message.timestamp_delta, 1500u);
+
+    ASSERT_TRUE(feed.ring().try_pop(message));
+    EXPECT_EQ(message.sequence, 2u);
+    EXPECT_EQ(message.type, FeedMessageType::DELETE);
+    EXPECT_EQ(message.order_id, 1u);
+    EXPECT_EQ(message.timestamp_delta, 1500u);
+
+    EXPECT_FALSE(feed.ring().try_pop(message));
+    engine.set_feed_publisher(nullptr);
+}
+
+TEST_F(MatchingEngineTest, FeedOrdersExecutionsBeforeRestingRemainder) {
+    FeedPublisher feed(64);
+    engine.set_feed_publisher(&feed);
+
+    engine.process_event(Event(EventType::LIMIT, 1, Side::SELL, 101, 40, 1000, 7));
+    // Crossing buy fills 40, rests 60: EXECUTE then ADD with remainder
+    engine.process_event(Event(EventType::LIMIT, 2, Side::BUY, 101, 100, 2000, 8));
+
+    FeedMessage message;
+    ASSERT_TRUE(feed.ring().try_pop(message)); // ADD of order 1
+    ASSERT_TRUE(feed.ring().try_pop(message));
+    EXPECT_EQ(message.type, FeedMessageType::EXECUTE);
+    EXPECT_EQ(message.order_id, 1u);
+    EXPECT_EQ(message.quantity, 40);
+    ASSERT_TRUE(feed.ring().try_pop(message));
+    EXPECT_EQ(message.type, FeedMessageType::ADD);
+    EXPECT_EQ(message.order_id, 2u);
+    EXPECT_EQ(message.quantity, 60); // Resting remainder, not the original size
+    EXPECT_EQ(message.side, 0);
+    engine.set_feed_publisher(nullptr);
+}
+
+TEST_F(MatchingEngineTest, FeedCountsDropsButKeepsSequencing) {
+    FeedPublisher feed(2); // Rounds to capacity 2
+    engine.set_feed_publisher(&feed);
+
+    for (OrderId id = 1; id <= 5; ++id) {
+        engine.process_event(Event(EventType::LIMIT, id, Side::BUY,
+                                   90 - static_cast<Price>(id), 10,
+                                   static_cast<Timestamp>(id) * 1000, 7));
+    }
+
+    EXPECT_EQ(feed.sequence(), 5u);
+    EXPECT_EQ(feed.dropped(), 3u);
+
+    // The consumer sees the gap through the sequence numbers
+    FeedMessage first;
+    FeedMessage second;
+    ASSERT_TRUE(feed.ring().try_pop(first));
+    ASSERT_TRUE(feed.ring().try_pop(second));
+    EXPECT_EQ(first.sequence, 0u);
+    EXPECT_EQ(second.sequence, 1u);
+    engine.set_feed_publisher(nullptr);
+}
+
+TEST_F(MatchingEngineTest, FastEngineMatchesDefaultEngine) {
+    // The specialized profile compiles callbacks, stats and journaling
+    // out; matching behavior must stay identical to the default alias
+    FastEngine fast;
+
+    std::vector<Event> events = {
+        Event(EventType::LIMIT, 1, Side::BUY, 9990, 100, 1000, 10),
+        Event(EventType::LIMIT, 2, Side::SELL, 10010, 80, 1001, 11),
+        Event(EventType::LIMIT, 3, Side::SELL, 9990, 40, 1002, 12),
+        Event(EventType::MARKET, 4, Side::BUY, 0, 30, 1003, 13),
+        Event(EventType::CANCEL, 1, Side::BUY, 0, 0, 1004, 10),
+    };
+
+    auto default_trades = engine.process_events(events);
+    auto fast_trades = fast.process_events(events);
+
+    ASSERT_EQ(default_trades.size(), fast_trades.size());
+    for (size_t i = 0; i < default_trades.size(); ++i) {
+        EXPECT_EQ(default_trades[i].maker_id, fast_trades[i].maker_id);
+        EXPECT_EQ(default_trades[i].taker_id, fast_trades[i].taker_id);
+        EXPECT_EQ(default_trades[i].price, fast_trades[i].price);
+        EXPECT_EQ(default_trades[i].quantity, fast_trades[i].quantity);
+    }
+    EXPECT_EQ(engine.order_count(), fast.order_count());
+    EXPECT_EQ(engine.total_volume(), fast.total_volume());
+    EXPECT_EQ(engine.last_trade_price(), fast.last_trade_price());
+
+    // The compiled-out machinery really is gone from the object layout
+    static_assert(sizeof(FastEngine) < sizeof(MatchingEngine),
+                  "FastEngine should carry no callback/stats/journal state");
+}
+
 } // namespace mms
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "mms/multi_instrument.hpp"
+
+namespace mms {
+
+class MultiInstrumentTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.n_instruments = 4;
+        config.n_threads = 2;
+        config.base.seed = 42;
+        config.base.output_dir.clear();
+    }
+
+    MultiInstrumentConfig config;
+};
+
+TEST_F(MultiInstrumentTest, RunsAllInstruments) {
+    MultiInstrumentSimulator sim(config);
+    auto result = sim.run(200);
+
+    EXPECT_EQ(result.instruments.size(), 4);
+    EXPECT_GT(result.total_events_processed, 0);
+    for (const auto& instrument : result.instruments) {
+        EXPECT_GT(instrument.total_events_processed, 0);
+    }
+}
+
+TEST_F(MultiInstrumentTest, MergedTradesAreTimestampOrdered) {
+    MultiInstrumentSimulator sim(config);
+    auto result = sim.run(500);
+
+    for (size_t i = 1; i < result.merged_trades.size(); ++i) {
+        EXPECT_LE(result.merged_trades[i - 1].trade.timestamp,
+                  result.merged_trades[i].trade.timestamp);
+    }
+
+    size_t merged_total = result.merged_trades.size();
+    size_t per_instrument_total = 0;
+    for (const auto& instrument : result.instruments) {
+        per_instrument_total += instrument.trades.size();
+    }
+    EXPECT_EQ(merged_total, per_instrument_total);
+}
+
+TEST_F(MultiInstrumentTest, DeterministicAcrossShardCounts) {
+    // Instruments are seeded independently, so results must not depend on
+    // how they are sharded across threads
+    MultiInstrumentSimulator sim1(config);
+    auto result1 = sim1.run(300);
+
+    config.n_threads = 4;
+    MultiInstrumentSimulator sim2(config);
+    auto result2 = sim2.run(300);
+
+    ASSERT_EQ(result1.instruments.size(), result2.instruments.size());
+    for (size_t i = 0; i < result1.instruments.size(); ++i) {
+        EXPECT_EQ(result1.instruments[i].total_events_processed,
+                  result2.instruments[i].total_events_processed);
+        EXPECT_EQ(result1.instruments[i].trades.size(),
+                  result2.instruments[i].trades.size());
+    }
+}
+
+} // namespace mms
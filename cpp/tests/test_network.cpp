@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "mms/network.hpp"
+#include "mms/simulator.hpp"
+
+namespace mms {
+
+class NetworkTest : public ::testing::Test {
+protected:
+    PendingEventQueue queue;
+};
+
+TEST_F(NetworkTest, QueueOrdersByDeliveryTimeThenSendOrder) {
+    // A maker cancel sent at t=0 over a slow link races a taker market
+    // order sent at t=50 over a fast one; the market order arrives first
+    Event cancel(EventType::CANCEL, 1, Side::BUY, 0, 0, 0, 10);
+    Event market(EventType::MARKET, 2, Side::SELL, 0, 100, 50, 11);
+    queue.push(cancel, 0 + 200);
+    queue.push(market, 50 + 60);
+
+    Event out;
+    ASSERT_TRUE(queue.pop_due(1000, out));
+    EXPECT_EQ(out.type, EventType::MARKET);
+    ASSERT_TRUE(queue.pop_due(1000, out));
+    EXPECT_EQ(out.type, EventType::CANCEL);
+    EXPECT_TRUE(queue.empty());
+
+    // Equal delivery times keep send order
+    queue.push(cancel, 500);
+    queue.push(market, 500);
+    ASSERT_TRUE(queue.pop_due(500, out));
+    EXPECT_EQ(out.type, EventType::CANCEL);
+    ASSERT_TRUE(queue.pop_due(500, out));
+    EXPECT_EQ(out.type, EventType::MARKET);
+}
+
+TEST_F(NetworkTest, QueueHoldsEventsUntilDue) {
+    Event event(EventType::LIMIT, 1, Side::BUY, 10000, 10, 0, 1);
+    queue.push(event, 300);
+
+    Event out;
+    EXPECT_FALSE(queue.pop_due(299, out));
+    EXPECT_EQ(queue.next_time(), 300);
+    EXPECT_TRUE(queue.pop_due(300, out));
+    EXPECT_EQ(out.order_id, 1u);
+}
+
+TEST_F(NetworkTest, ModelAppliesPerAgentOverrides) {
+    NetworkConfig config;
+    config.default_delay.model = DelayModel::FIXED;
+    config.default_delay.fixed_delay = 100;
+    config.agent_delays[7].model = DelayModel::FIXED;
+    config.agent_delays[7].fixed_delay = 2500;
+
+    RNG master(42);
+    NetworkModel model;
+    model.reset(config, master);
+
+    EXPECT_TRUE(model.enabled());
+    EXPECT_EQ(model.sample_delay(1), 100);
+    EXPECT_EQ(model.sample_delay(7), 2500);
+}
+
+TEST_F(NetworkTest, LognormalAndEmpiricalDelaysAreReproducible) {
+    NetworkConfig config;
+    config.default_delay.model = DelayModel::LOGNORMAL;
+    config.default_delay.lognormal_mu = 8.0;
+    config.default_delay.lognormal_sigma = 0.5;
+    config.agent_delays[2].model = DelayModel::EMPIRICAL;
+    config.agent_delays[2].empirical_delays = {150, 300, 900};
+
+    RNG master(42);
+    NetworkModel first;
+    NetworkModel second;
+    first.reset(config, master);
+    second.reset(config, master);
+
+    for (int i = 0; i < 100; ++i) {
+        Timestamp lognormal = first.sample_delay(1);
+        EXPECT_GT(lognormal, 0);
+        EXPECT_EQ(lognormal, second.sample_delay(1));
+
+        Timestamp empirical = first.sample_delay(2);
+        EXPECT_TRUE(empirical == 150 || empirical == 300 || empirical == 900);
+        EXPECT_EQ(empirical, second.sample_delay(2));
+    }
+}
+
+TEST_F(NetworkTest, DelayedSimulationRunsDeterministically) {
+    SimulationConfig config;
+    config.seed = 42;
+    config.time_step = 1000;
+    config.output_dir = "";
+    config.network.default_delay.model = DelayModel::FIXED;
+    config.network.default_delay.fixed_delay = 5000;
+
+    Simulator first(config);
+    auto first_result = first.run(2000);
+
+    Simulator second(config);
+    auto second_result = second.run(2000);
+
+    EXPECT_GT(first_result.total_events_processed, 0u);
+    EXPECT_GT(first_result.total_trades, 0u);
+    EXPECT_EQ(first_result.total_events_processed, second_result.total_events_processed);
+    EXPECT_EQ(first_result.total_trades, second_result.total_trades);
+    ASSERT_EQ(first_result.trades.size(), second_result.trades.size());
+    for (size_t i = 0; i < first_result.trades.size(); ++i) {
+        EXPECT_EQ(first_result.trades[i].price, second_result.trades[i].price);
+        EXPECT_EQ(first_result.trades[i].timestamp, second_result.trades[i].timestamp);
+    }
+}
+
+TEST_F(NetworkTest, EventDrivenLoopInterleavesDelayedDeliveries) {
+    SimulationConfig config;
+    config.seed = 42;
+    config.time_step = 1000;
+    config.output_dir = "";
+    config.event_driven = true;
+    config.network.default_delay.model = DelayModel::LOGNORMAL;
+    config.network.default_delay.lognormal_mu = 9.0;
+    config.network.default_delay.lognormal_sigma = 0.8;
+
+    Simulator simulator(config);
+    auto result = simulator.run(2000);
+
+    EXPECT_GT(result.total_events_processed, 0u);
+    EXPECT_GT(result.total_trades, 0u);
+}
+
+} // namespace mms
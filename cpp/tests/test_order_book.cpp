@@ -230,6 +230,129 @@ TEST_F(OrderBookTest, ClearBook) {
     EXPECT_EQ(book.total_volume(), 0);
 }
 
+TEST_F(OrderBookTest, ReserveDoesNotAffectState) {
+    book.reserve(1000);
+    EXPECT_TRUE(book.empty());
+    EXPECT_EQ(book.size(), 0);
+
+    Order order(1, Side::BUY, 10000, 100, 1000);
+    EXPECT_TRUE(book.add_limit_order(order));
+    EXPECT_EQ(book.size(), 1);
+}
+
+TEST_F(OrderBookTest, CancelFromMiddleOfDeepLevel) {
+    // Fill one price level with many orders and cancel from the middle
+    const int n_orders = 100;
+    for (int i = 1; i <= n_orders; ++i) {
+        Order order(static_cast<OrderId>(i), Side::BUY, 10000, 10, 1000 + i);
+        EXPECT_TRUE(book.add_limit_order(order));
+    }
+    EXPECT_EQ(book.size(), n_orders);
+    EXPECT_EQ(book.best_bid_quantity().value(), 10 * n_orders);
+
+    // Cancel an order from the middle of the queue
+    EXPECT_TRUE(book.cancel_order(50));
+    EXPECT_EQ(book.size(), n_orders - 1);
+    EXPECT_EQ(book.best_bid_quantity().value(), 10 * (n_orders - 1));
+    EXPECT_FALSE(book.get_order(50).has_value());
+
+    // Time priority of the remaining orders is preserved
+    auto trades = book.add_market_order(Side::SELL, 10, 999, 2000);
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].maker_id, 1);
+}
+
+TEST_F(OrderBookTest, NodeReuseAfterCancel) {
+    // Cancelled node slots are recycled for subsequent orders
+    Order order1(1, Side::BUY, 10000, 100, 1000);
+    EXPECT_TRUE(book.add_limit_order(order1));
+    EXPECT_TRUE(book.cancel_order(1));
+
+    Order order2(2, Side::SELL, 10005, 50, 1001);
+    EXPECT_TRUE(book.add_limit_order(order2));
+
+    auto retrieved = book.get_order(2);
+    ASSERT_TRUE(retrieved.has_value());
+    EXPECT_EQ(retrieved->price, 10005);
+    EXPECT_EQ(retrieved->quantity, 50);
+}
+
+class LadderOrderBookTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        LadderConfig config;
+        config.anchor_price = 10000;
+        config.half_width = 100;
+        book = std::make_unique<OrderBook>(config);
+    }
+
+    std::unique_ptr<OrderBook> book;
+};
+
+TEST_F(LadderOrderBookTest, BasicAddAndBestPrices) {
+    EXPECT_TRUE(book->uses_ladder());
+    EXPECT_TRUE(book->add_limit_order(Order(1, Side::BUY, 10000, 100, 1000)));
+    EXPECT_TRUE(book->add_limit_order(Order(2, Side::SELL, 10002, 50, 1001)));
+
+    EXPECT_EQ(book->best_bid_price().value(), 10000);
+    EXPECT_EQ(book->best_ask_price().value(), 10002);
+    EXPECT_EQ(book->best_bid_quantity().value(), 100);
+    EXPECT_EQ(book->best_ask_quantity().value(), 50);
+}
+
+TEST_F(LadderOrderBookTest, RejectsOrdersOutsideBand) {
+    // Band is [9900, 10100]
+    EXPECT_FALSE(book->add_limit_order(Order(1, Side::BUY, 9800, 100, 1000)));
+    EXPECT_FALSE(book->add_limit_order(Order(2, Side::SELL, 10200, 100, 1000)));
+    EXPECT_TRUE(book->add_limit_order(Order(3, Side::BUY, 9900, 100, 1000)));
+    EXPECT_TRUE(book->add_limit_order(Order(4, Side::SELL, 10100, 100, 1000)));
+    EXPECT_EQ(book->size(), 2);
+}
+
+TEST_F(LadderOrderBookTest, MarketOrderSweepsLevels) {
+    EXPECT_TRUE(book->add_limit_order(Order(1, Side::SELL, 10001, 30, 1000)));
+    EXPECT_TRUE(book->add_limit_order(Order(2, Side::SELL, 10002, 30, 1001)));
+    EXPECT_TRUE(book->add_limit_order(Order(3, Side::SELL, 10003, 30, 1002)));
+
+    auto trades = book->add_market_order(Side::BUY, 70, 99, 2000);
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades[0].price, 10001);
+    EXPECT_EQ(trades[1].price, 10002);
+    EXPECT_EQ(trades[2].price, 10003);
+    EXPECT_EQ(trades[2].quantity, 10);
+    EXPECT_EQ(book->best_ask_price().value(), 10003);
+    EXPECT_EQ(book->best_ask_quantity().value(), 20);
+}
+
+TEST_F(LadderOrderBookTest, CrossingLimitOrderAndCancel) {
+    EXPECT_TRUE(book->add_limit_order(Order(1, Side::BUY, 10000, 100, 1000)));
+
+    TradeList trades;
+    EXPECT_TRUE(book->add_limit_order(Order(2, Side::SELL, 9999, 40, 1001), trades));
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].price, 10000);
+    EXPECT_EQ(trades[0].quantity, 40);
+    EXPECT_EQ(book->best_bid_quantity().value(), 60);
+
+    EXPECT_TRUE(book->cancel_order(1));
+    EXPECT_FALSE(book->best_bid_price().has_value());
+    EXPECT_TRUE(book->empty());
+}
+
+TEST_F(LadderOrderBookTest, DepthSnapshot) {
+    EXPECT_TRUE(book->add_limit_order(Order(1, Side::BUY, 10000, 100, 1000)));
+    EXPECT_TRUE(book->add_limit_order(Order(2, Side::BUY, 9998, 200, 1001)));
+    EXPECT_TRUE(book->add_limit_order(Order(3, Side::SELL, 10002, 50, 1002)));
+
+    auto depth = book->get_depth(5);
+    ASSERT_EQ(depth.size(), 3);
+    EXPECT_EQ(depth[0].price, 10000);
+    EXPECT_EQ(depth[0].bid_quantity, 100);
+    EXPECT_EQ(depth[1].price, 9998);
+    EXPECT_EQ(depth[2].price, 10002);
+    EXPECT_EQ(depth[2].ask_quantity, 50);
+}
+
 TEST_F(OrderBookTest, CrossingOrders) {
     // Add buy order
     Order buy_order(1, Side::BUY, 10000, 100, 1000);
@@ -245,4 +368,217 @@ TEST_F(OrderBookTest, CrossingOrders) {
     EXPECT_GT(book.total_volume(), 0);
 }
 
+TEST_F(OrderBookTest, DepthCacheTracksMutations) {
+    book.add_limit_order(Order(1, Side::BUY, 100, 10, 1000));
+    book.add_limit_order(Order(2, Side::BUY, 99, 20, 1001));
+    book.add_limit_order(Order(3, Side::SELL, 102, 15, 1002));
+
+    auto bids = book.bid_depth();
+    auto asks = book.ask_depth();
+    ASSERT_EQ(bids.size(), 2u);
+    EXPECT_EQ(bids[0].price, 100);
+    EXPECT_EQ(bids[0].bid_quantity, 10);
+    EXPECT_EQ(bids[1].price, 99);
+    ASSERT_EQ(asks.size(), 1u);
+    EXPECT_EQ(asks[0].price, 102);
+    EXPECT_EQ(asks[0].ask_quantity, 15);
+
+    // Cancelling the best bid must show up in the next view
+    uint64_t version_before = book.version();
+    book.cancel_order(1);
+    EXPECT_GT(book.version(), version_before);
+
+    bids = book.bid_depth();
+    ASSERT_EQ(bids.size(), 1u);
+    EXPECT_EQ(bids[0].price, 99);
+}
+
+TEST_F(OrderBookTest, VersionStableWithoutMutations) {
+    book.add_limit_order(Order(1, Side::BUY, 100, 10, 1000));
+
+    uint64_t version = book.version();
+    auto bids = book.bid_depth();
+    EXPECT_EQ(bids.size(), 1u);
+    EXPECT_EQ(book.version(), version); // Reads never bump the version
+
+    // A failed cancel is not a mutation
+    EXPECT_FALSE(book.cancel_order(999));
+    EXPECT_EQ(book.version(), version);
+}
+
+TEST_F(OrderBookTest, AdmissionBandRejectsFarOrders) {
+    AdmissionConfig admission;
+    admission.max_distance_from_mid = 10;
+    book.set_admission_config(admission);
+
+    // Establish a mid of 100
+    EXPECT_TRUE(book.add_limit_order(Order(1, Side::BUY, 99, 100, 0)));
+    EXPECT_TRUE(book.add_limit_order(Order(2, Side::SELL, 101, 100, 0)));
+
+    // Within the band
+    EXPECT_TRUE(book.add_limit_order(Order(3, Side::BUY, 95, 100, 0)));
+
+    // Beyond the band: rejected, never rests
+    EXPECT_FALSE(book.add_limit_order(Order(4, Side::BUY, 50, 100, 0)));
+    EXPECT_FALSE(book.get_order(4).has_value());
+    EXPECT_EQ(book.rejected_band_count(), 1u);
+    EXPECT_EQ(book.size(), 3u);
+}
+
+TEST_F(OrderBookTest, AdmissionCapLimitsRestingOrdersPerSide) {
+    AdmissionConfig admission;
+    admission.max_orders_per_side = 2;
+    book.set_admission_config(admission);
+
+    EXPECT_TRUE(book.add_limit_order(Order(1, Side::BUY, 99, 100, 0)));
+    EXPECT_TRUE(book.add_limit_order(Order(2, Side::BUY, 98, 100, 0)));
+    EXPECT_FALSE(book.add_limit_order(Order(3, Side::BUY, 97, 100, 0)));
+    EXPECT_EQ(book.rejected_cap_count(), 1u);
+
+    // The cap is per side: asks still have room
+    EXPECT_TRUE(book.add_limit_order(Order(4, Side::SELL, 101, 100, 0)));
+
+    // Cancelling frees a slot
+    EXPECT_TRUE(book.cancel_order(1));
+    EXPECT_TRUE(book.add_limit_order(Order(5, Side::BUY, 97, 100, 0)));
+}
+
+TEST_F(OrderBookTest, TtlExpiresStaleOrdersDuringMatching) {
+    AdmissionConfig admission;
+    admission.order_ttl = 1000;
+    book.set_admission_config(admission);
+
+    // A stale ask in front of a fresh one at the same price
+    EXPECT_TRUE(book.add_limit_order(Order(1, Side::SELL, 101, 100, 0)));
+    EXPECT_TRUE(book.add_limit_order(Order(2, Side::SELL, 101, 100, 1500)));
+
+    // A crossing buy at t=2000 skips and evicts the expired maker, then
+    // fills against the fresh one
+    TradeList trades{};
+    EXPECT_TRUE(book.add_limit_order(Order(3, Side::BUY, 101, 100, 2000), trades));
+
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].maker_id, 2u);
+    EXPECT_EQ(book.expired_count(), 1u);
+    ASSERT_EQ(book.expired_order_ids().size(), 1u);
+    EXPECT_EQ(book.expired_order_ids()[0], 1u);
+    EXPECT_FALSE(book.get_order(1).has_value());
+    EXPECT_TRUE(book.empty());
+}
+
+TEST_F(OrderBookTest, TradelessExpiryStillBumpsVersion) {
+    AdmissionConfig admission;
+    admission.order_ttl = 1000;
+    book.set_admission_config(admission);
+
+    EXPECT_TRUE(book.add_limit_order(Order(1, Side::SELL, 101, 100, 0)));
+    auto asks = book.ask_depth();
+    ASSERT_EQ(asks.size(), 1u);
+
+    // A market buy at t=2000 finds only the expired maker: zero trades,
+    // but the book mutates and cached depth must not serve the stale level
+    uint64_t version_before = book.version();
+    auto trades = book.add_market_order(Side::BUY, 50, 2, 2000);
+    EXPECT_TRUE(trades.empty());
+    EXPECT_EQ(book.expired_count(), 1u);
+    EXPECT_GT(book.version(), version_before);
+
+    asks = book.ask_depth();
+    EXPECT_TRUE(asks.empty());
+    EXPECT_TRUE(book.empty());
+}
+
+TEST_F(OrderBookTest, AdmissionFillsStandWhenRemainderIsRejected) {
+    AdmissionConfig admission;
+    admission.max_orders_per_side = 1;
+    book.set_admission_config(admission);
+
+    EXPECT_TRUE(book.add_limit_order(Order(1, Side::SELL, 101, 50, 0)));
+    EXPECT_TRUE(book.add_limit_order(Order(2, Side::BUY, 99, 50, 0)));
+
+    // Crossing buy fills 50 and its remainder hits the bid-side cap
+    TradeList trades{};
+    EXPECT_TRUE(book.add_limit_order(Order(3, Side::BUY, 101, 100, 0), trades));
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].quantity, 50);
+    EXPECT_FALSE(book.get_order(3).has_value());
+    EXPECT_EQ(book.rejected_cap_count(), 1u);
+}
+
+TEST_F(OrderBookTest, QueuePositionTracksFillsAndCancels) {
+    book.add_limit_order(Order(1, Side::BUY, 9990, 10, 1000));
+    book.add_limit_order(Order(2, Side::BUY, 9990, 20, 1001));
+    book.add_limit_order(Order(3, Side::BUY, 9990, 30, 1002));
+
+    EXPECT_EQ(book.queue_position(1).value(), 0);
+    EXPECT_EQ(book.queue_position(2).value(), 10);
+    EXPECT_EQ(book.queue_position(3).value(), 30);
+    EXPECT_FALSE(book.queue_position(999).has_value());
+
+    // Cancelling ahead of an order shortens its queue
+    EXPECT_TRUE(book.cancel_order(1));
+    EXPECT_EQ(book.queue_position(2).value(), 0);
+    EXPECT_EQ(book.queue_position(3).value(), 20);
+
+    // A partial fill at the front shortens it too
+    TradeList trades(std::pmr::get_default_resource());
+    book.add_limit_order(Order(4, Side::SELL, 9990, 5, 1003), trades);
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(book.queue_position(2).value(), 0);
+    EXPECT_EQ(book.queue_position(3).value(), 15);
+
+    // Filled-out orders are no longer resting
+    book.add_limit_order(Order(5, Side::SELL, 9990, 15, 1004), trades);
+    EXPECT_FALSE(book.queue_position(2).has_value());
+    EXPECT_EQ(book.queue_position(3).value(), 0);
+}
+
+TEST_F(OrderBookTest, QueuePositionSurvivesMidQueueCancels) {
+    for (OrderId id = 1; id <= 8; ++id) {
+        book.add_limit_order(Order(id, Side::SELL, 10010, 10, 1000 + static_cast<Timestamp>(id)));
+    }
+    EXPECT_EQ(book.queue_position(8).value(), 70);
+
+    // Remove from the middle, not the front
+    EXPECT_TRUE(book.cancel_order(3));
+    EXPECT_TRUE(book.cancel_order(6));
+    EXPECT_EQ(book.queue_position(2).value(), 10);
+    EXPECT_EQ(book.queue_position(4).value(), 20);
+    EXPECT_EQ(book.queue_position(8).value(), 50);
+}
+
+TEST_F(OrderBookTest, LevelImbalanceBracketsPrice) {
+    EXPECT_DOUBLE_EQ(book.level_imbalance(10000), 0.0);
+
+    book.add_limit_order(Order(1, Side::BUY, 9990, 100, 1000));
+    book.add_limit_order(Order(2, Side::BUY, 9985, 20, 1001));
+    book.add_limit_order(Order(3, Side::SELL, 10010, 50, 1002));
+
+    // At the mid: best bid vs best ask
+    EXPECT_DOUBLE_EQ(book.level_imbalance(10000), (100.0 - 50.0) / 150.0);
+
+    // At the second bid level: that level against the best ask
+    EXPECT_DOUBLE_EQ(book.level_imbalance(9987), (20.0 - 50.0) / 70.0);
+
+    // Below all bids: ask side only
+    EXPECT_DOUBLE_EQ(book.level_imbalance(9000), -1.0);
+
+    // Above all asks: bid side only
+    EXPECT_DOUBLE_EQ(book.level_imbalance(11000), 1.0);
+}
+
+TEST_F(LadderOrderBookTest, QueuePositionAndImbalanceOnLadder) {
+    book->add_limit_order(Order(1, Side::BUY, 9995, 40, 1000));
+    book->add_limit_order(Order(2, Side::BUY, 9995, 25, 1001));
+    book->add_limit_order(Order(3, Side::SELL, 10005, 30, 1002));
+
+    EXPECT_EQ(book->queue_position(1).value(), 0);
+    EXPECT_EQ(book->queue_position(2).value(), 40);
+    EXPECT_DOUBLE_EQ(book->level_imbalance(10000), (65.0 - 30.0) / 95.0);
+
+    EXPECT_TRUE(book->cancel_order(1));
+    EXPECT_EQ(book->queue_position(2).value(), 0);
+    EXPECT_DOUBLE_EQ(book->level_imbalance(10000), (25.0 - 30.0) / 55.0);
+}
+
 } // namespace mms
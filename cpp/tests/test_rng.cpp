@@ -126,9 +126,10 @@ TEST_F(RNGTest, SeedReset) {
     int val2 = rng2.uniform_int(1, 100);
     EXPECT_NE(val1, val2);
     
-    // Reset rng2 with same seed as rng1
+    // Reset both with the same seed
+    rng1.seed(123);
     rng2.seed(123);
-    
+
     // Now they should produce the same sequence
     EXPECT_EQ(rng1.uniform_int(1, 100), rng2.uniform_int(1, 100));
 }
@@ -147,4 +148,52 @@ TEST_F(RNGTest, ContainerShuffle) {
     EXPECT_EQ(original, shuffled);
 }
 
+TEST_F(RNGTest, SplitStreamsAreIndependent) {
+    RNG parent(42);
+    RNG child1 = parent.split();
+    RNG child2 = parent.split();
+
+    // Splits from the same parent must not mirror each other or the parent
+    bool children_differ = false;
+    bool child_differs_from_parent = false;
+    RNG parent_replay(42);
+    RNG replay_child = parent_replay.split();
+    (void)replay_child;
+    for (int i = 0; i < 100; ++i) {
+        uint64_t a = child1.uniform_int<uint64_t>(0, UINT64_MAX - 1);
+        uint64_t b = child2.uniform_int<uint64_t>(0, UINT64_MAX - 1);
+        uint64_t c = parent_replay.uniform_int<uint64_t>(0, UINT64_MAX - 1);
+        if (a != b) children_differ = true;
+        if (a != c) child_differs_from_parent = true;
+    }
+    EXPECT_TRUE(children_differ);
+    EXPECT_TRUE(child_differs_from_parent);
+}
+
+TEST_F(RNGTest, SplitIsDeterministic) {
+    RNG parent1(123);
+    RNG parent2(123);
+    RNG child1 = parent1.split();
+    RNG child2 = parent2.split();
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(child1.uniform_int(0, 1000000), child2.uniform_int(0, 1000000));
+    }
+}
+
+TEST_F(RNGTest, UniformIntCoversFullBound) {
+    RNG rng(7);
+    bool saw_min = false;
+    bool saw_max = false;
+    for (int i = 0; i < 10000; ++i) {
+        int value = rng.uniform_int(0, 7);
+        ASSERT_GE(value, 0);
+        ASSERT_LE(value, 7);
+        if (value == 0) saw_min = true;
+        if (value == 7) saw_max = true;
+    }
+    EXPECT_TRUE(saw_min);
+    EXPECT_TRUE(saw_max);
+}
+
 } // namespace mms
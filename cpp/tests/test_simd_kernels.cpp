@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "mms/simd_kernels.hpp"
+#include "mms/rng.hpp"
+#include <cmath>
+#include <vector>
+
+namespace mms {
+namespace analysis {
+
+// Sizes straddling the 4-lane vector width, including tails and the
+// scalar-only small cases
+static const size_t kSizes[] = {1, 2, 3, 4, 5, 7, 8, 100, 1001};
+
+TEST(SimdKernelsTest, SumMatchesScalarReference) {
+    RNG rng(42);
+    for (size_t n : kSizes) {
+        std::vector<int64_t> values(n);
+        double expected = 0.0;
+        for (auto& v : values) {
+            v = rng.uniform_int<int64_t>(-100000, 100000);
+            expected += static_cast<double>(v);
+        }
+        EXPECT_DOUBLE_EQ(simd::sum(values.data(), n), expected) << "n=" << n;
+    }
+}
+
+TEST(SimdKernelsTest, DotMatchesScalarReference) {
+    RNG rng(43);
+    for (size_t n : kSizes) {
+        std::vector<int64_t> a(n);
+        std::vector<int64_t> b(n);
+        double expected = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = rng.uniform_int<int64_t>(1, 20000);
+            b[i] = rng.uniform_int<int64_t>(1, 1000);
+            expected += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+        }
+        EXPECT_NEAR(simd::dot(a.data(), b.data(), n), expected, std::abs(expected) * 1e-12)
+            << "n=" << n;
+    }
+}
+
+TEST(SimdKernelsTest, MinMaxHandlesNegativesAndTails) {
+    RNG rng(44);
+    for (size_t n : kSizes) {
+        std::vector<int64_t> values(n);
+        int64_t expected_min = INT64_MAX;
+        int64_t expected_max = INT64_MIN;
+        for (auto& v : values) {
+            v = rng.uniform_int<int64_t>(-1000000, 1000000);
+            expected_min = std::min(expected_min, v);
+            expected_max = std::max(expected_max, v);
+        }
+        auto result = simd::min_max(values.data(), n);
+        EXPECT_EQ(result.min, expected_min) << "n=" << n;
+        EXPECT_EQ(result.max, expected_max) << "n=" << n;
+    }
+}
+
+TEST(SimdKernelsTest, MeanVarianceMatchesTwoPassReference) {
+    RNG rng(45);
+    for (size_t n : kSizes) {
+        std::vector<double> values(n);
+        for (auto& v : values) {
+            v = rng.normal(5.0, 2.0);
+        }
+
+        double mean = 0.0;
+        for (double v : values) {
+            mean += v;
+        }
+        mean /= static_cast<double>(n);
+        double variance = 0.0;
+        for (double v : values) {
+            variance += (v - mean) * (v - mean);
+        }
+        variance /= static_cast<double>(n);
+
+        auto result = simd::mean_variance(values.data(), n);
+        EXPECT_NEAR(result.mean, mean, 1e-9) << "n=" << n;
+        EXPECT_NEAR(result.variance, variance, 1e-9) << "n=" << n;
+    }
+}
+
+TEST(SimdKernelsTest, IntegerMeanVarianceIsExactOnConstants) {
+    std::vector<int64_t> values(100, 7);
+    auto result = simd::mean_variance(values.data(), values.size());
+    EXPECT_DOUBLE_EQ(result.mean, 7.0);
+    EXPECT_DOUBLE_EQ(result.variance, 0.0);
+}
+
+} // namespace analysis
+} // namespace mms
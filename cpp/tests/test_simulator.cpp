@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "mms/simulator.hpp"
 #include "mms/types.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 
 namespace mms {
 
@@ -208,6 +211,187 @@ TEST_F(SimulatorTest, ConfigurationUpdate) {
     EXPECT_NE(result1.total_events_processed, result2.total_events_processed);
 }
 
+// Helper for the columnar-output tests: reads one 64-bit column back out
+// of a blocked columnar file, concatenating across blocks
+static std::vector<int64_t> read_binary_column(const std::string& path,
+                                               uint32_t expected_columns,
+                                               size_t column_index) {
+    std::ifstream in(path, std::ios::binary);
+    EXPECT_TRUE(in.is_open());
+
+    char magic[4];
+    uint32_t version = 0, n_columns = 0, reserved = 0;
+    in.read(magic, 4);
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&n_columns), sizeof(n_columns));
+    in.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+    EXPECT_EQ(std::memcmp(magic, "MMSC", 4), 0);
+    EXPECT_EQ(version, 1u);
+    EXPECT_EQ(n_columns, expected_columns);
+
+    std::vector<int64_t> values;
+    uint64_t n_rows = 0;
+    while (in.read(reinterpret_cast<char*>(&n_rows), sizeof(n_rows))) {
+        for (size_t col = 0; col < n_columns; ++col) {
+            std::vector<int64_t> column(n_rows);
+            in.read(reinterpret_cast<char*>(column.data()),
+                    static_cast<std::streamsize>(n_rows * sizeof(int64_t)));
+            if (col == column_index) {
+                values.insert(values.end(), column.begin(), column.end());
+            }
+        }
+    }
+    return values;
+}
+
+TEST_F(SimulatorTest, BinaryColumnarRoundTrip) {
+    auto output_dir = std::filesystem::temp_directory_path() / "mms_binary_test";
+    std::filesystem::create_directories(output_dir);
+
+    MarketDataCollector collector;
+    collector.record_trade(Trade{1, 2, 100, 10, 5000});
+    collector.record_trade(Trade{3, 4, 101, 20, 6000});
+    MarketSnapshot snapshot{};
+    snapshot.timestamp = 7000;
+    snapshot.best_bid = 99;
+    snapshot.best_ask = 101;
+    collector.record_snapshot(snapshot);
+    collector.record_agent_pnl(1, 7000, 12.5, 30);
+    collector.save_to_binary(output_dir.string());
+
+    auto prices = read_binary_column((output_dir / "trades.bin").string(), 5, 3);
+    ASSERT_EQ(prices.size(), 2u);
+    EXPECT_EQ(prices[0], 100);
+    EXPECT_EQ(prices[1], 101);
+
+    auto bids = read_binary_column((output_dir / "market_snapshots.bin").string(), 6, 1);
+    ASSERT_EQ(bids.size(), 1u);
+    EXPECT_EQ(bids[0], 99);
+
+    auto pnl_bits = read_binary_column((output_dir / "agent_pnl.bin").string(), 4, 2);
+    ASSERT_EQ(pnl_bits.size(), 1u);
+    double pnl;
+    std::memcpy(&pnl, &pnl_bits[0], sizeof(pnl));
+    EXPECT_DOUBLE_EQ(pnl, 12.5);
+
+    std::filesystem::remove_all(output_dir);
+}
+
+TEST_F(SimulatorTest, BinaryStreamingFlushesBlocks) {
+    auto output_dir = std::filesystem::temp_directory_path() / "mms_streaming_test";
+    std::filesystem::create_directories(output_dir);
+
+    MarketDataCollector collector;
+    collector.enable_streaming(output_dir.string(), 2);
+    for (int i = 0; i < 5; ++i) {
+        collector.record_trade(Trade{1, 2, 100 + i, 10, 1000 * (i + 1)});
+    }
+    // Two full blocks are on disk; the current block holds the odd row out
+    EXPECT_EQ(collector.get_trades().size(), 1u);
+    collector.finish_streaming();
+
+    auto timestamps = read_binary_column((output_dir / "trades.bin").string(), 5, 0);
+    ASSERT_EQ(timestamps.size(), 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(timestamps[static_cast<size_t>(i)], 1000 * (i + 1));
+    }
+
+    std::filesystem::remove_all(output_dir);
+}
+
+TEST_F(SimulatorTest, BinaryOutputFromRun) {
+    auto output_dir = std::filesystem::temp_directory_path() / "mms_binary_run_test";
+    std::filesystem::create_directories(output_dir);
+
+    config.output_dir = output_dir.string();
+    config.binary_output = true;
+    simulator = std::make_unique<Simulator>(config);
+
+    auto result = simulator->run(200);
+    auto prices = read_binary_column((output_dir / "trades.bin").string(), 5, 3);
+    EXPECT_EQ(prices.size(), result.trades.size());
+
+    std::filesystem::remove_all(output_dir);
+}
+
+TEST_F(SimulatorTest, EventDrivenModeRuns) {
+    config.event_driven = true;
+    simulator = std::make_unique<Simulator>(config);
+    
+    auto result = simulator->run(1000);
+    
+    // Agents still act and trade; the scheduler just skips idle steps
+    EXPECT_GT(result.total_events_processed, 0);
+    EXPECT_GT(result.total_trades, 0);
+    EXPECT_EQ(result.simulation_duration,
+              static_cast<Timestamp>(1000) * config.time_step);
+}
+
+TEST_F(SimulatorTest, EventDrivenModeIsDeterministic) {
+    config.event_driven = true;
+    
+    Simulator sim1(config);
+    Simulator sim2(config);
+    auto result1 = sim1.run(500);
+    auto result2 = sim2.run(500);
+    
+    EXPECT_EQ(result1.total_events_processed, result2.total_events_processed);
+    EXPECT_EQ(result1.total_trades, result2.total_trades);
+    ASSERT_EQ(result1.trades.size(), result2.trades.size());
+    for (size_t i = 0; i < result1.trades.size(); ++i) {
+        EXPECT_EQ(result1.trades[i].timestamp, result2.trades[i].timestamp);
+        EXPECT_EQ(result1.trades[i].price, result2.trades[i].price);
+    }
+}
+
+TEST_F(SimulatorTest, PipelinedModeMatchesSequential) {
+    Simulator sequential(config);
+    auto expected = sequential.run(500);
+    
+    config.pipelined = true;
+    Simulator pipelined(config);
+    auto actual = pipelined.run(500);
+    
+    // The step barrier makes the pipelined mode replay the exact
+    // sequential event/trade interleaving
+    EXPECT_EQ(actual.total_events_processed, expected.total_events_processed);
+    EXPECT_EQ(actual.total_trades, expected.total_trades);
+    ASSERT_EQ(actual.trades.size(), expected.trades.size());
+    for (size_t i = 0; i < expected.trades.size(); ++i) {
+        EXPECT_EQ(actual.trades[i].timestamp, expected.trades[i].timestamp);
+        EXPECT_EQ(actual.trades[i].price, expected.trades[i].price);
+        EXPECT_EQ(actual.trades[i].quantity, expected.trades[i].quantity);
+        EXPECT_EQ(actual.trades[i].maker_id, expected.trades[i].maker_id);
+        EXPECT_EQ(actual.trades[i].taker_id, expected.trades[i].taker_id);
+    }
+}
+
+TEST_F(SimulatorTest, UnchangedBookSkipsSnapshots) {
+    // With no agents the book never changes, so the dirty check should
+    // collapse periodic collection to a single snapshot
+    auto result = simulator->run_with_agents(500, {});
+    
+    EXPECT_EQ(result.total_events_processed, 0u);
+    EXPECT_EQ(result.market_snapshots.size(), 1u);
+}
+
+TEST_F(SimulatorTest, ColumnarAnalysisMatchesRowwise) {
+    auto result = simulator->run(500);
+    const auto& collector = simulator->get_data_collector();
+    
+    // Column views stay consistent with the materialized rows
+    ASSERT_EQ(collector.trade_columns().size(), result.trades.size());
+    ASSERT_EQ(collector.snapshot_columns().size(), result.market_snapshots.size());
+    
+    EXPECT_DOUBLE_EQ(analysis::calculate_vwap(collector.trade_columns()),
+                     analysis::calculate_vwap(result.trades));
+    EXPECT_DOUBLE_EQ(analysis::calculate_twap(collector.snapshot_columns()),
+                     analysis::calculate_twap(result.market_snapshots));
+    // Column path uses a one-pass SIMD variance; agreement is to rounding
+    EXPECT_NEAR(analysis::calculate_realized_volatility(collector.snapshot_columns()),
+                analysis::calculate_realized_volatility(result.market_snapshots), 1e-9);
+}
+
 TEST_F(SimulatorTest, OutputDirectory) {
     const std::string output_dir = "test_output";
     simulator->set_output_dir(output_dir);
@@ -222,4 +406,151 @@ TEST_F(SimulatorTest, OutputDirectory) {
     EXPECT_GT(result.total_events_processed, 0);
 }
 
+TEST_F(SimulatorTest, CheckpointRoundTripResumesBitExact) {
+    std::string path = (std::filesystem::temp_directory_path() / "mms_test_checkpoint.bin").string();
+
+    // Full-horizon reference run
+    Simulator reference(config);
+    auto full = reference.run(1000);
+
+    // Split run: first half, checkpoint, second half
+    Simulator split(config);
+    split.run(500);
+    ASSERT_TRUE(split.save_checkpoint(path));
+    auto split_result = split.resume(500);
+
+    // Splitting the horizon must not change the trade stream
+    ASSERT_EQ(split_result.trades.size(), full.trades.size());
+    for (size_t i = 0; i < full.trades.size(); ++i) {
+        EXPECT_EQ(split_result.trades[i].maker_id, full.trades[i].maker_id);
+        EXPECT_EQ(split_result.trades[i].price, full.trades[i].price);
+        EXPECT_EQ(split_result.trades[i].timestamp, full.trades[i].timestamp);
+    }
+
+    // Restoring the checkpoint into a fresh simulator with the same
+    // agent lineup resumes the identical stream
+    Simulator restored(config);
+    restored.run(500); // Register the same agents, then discard the state
+    ASSERT_TRUE(restored.restore_checkpoint(path));
+    auto restored_result = restored.resume(500);
+
+    ASSERT_EQ(restored_result.trades.size(), split_result.trades.size());
+    for (size_t i = 0; i < split_result.trades.size(); ++i) {
+        EXPECT_EQ(restored_result.trades[i].maker_id, split_result.trades[i].maker_id);
+        EXPECT_EQ(restored_result.trades[i].taker_id, split_result.trades[i].taker_id);
+        EXPECT_EQ(restored_result.trades[i].price, split_result.trades[i].price);
+        EXPECT_EQ(restored_result.trades[i].quantity, split_result.trades[i].quantity);
+        EXPECT_EQ(restored_result.trades[i].timestamp, split_result.trades[i].timestamp);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_F(SimulatorTest, CheckpointRestoresBookState) {
+    std::string path = (std::filesystem::temp_directory_path() / "mms_test_checkpoint2.bin").string();
+
+    Simulator sim(config);
+    sim.run(300);
+    const auto& book = sim.get_matching_engine().get_order_book();
+    size_t orders = sim.get_matching_engine().order_count();
+    size_t trades = book.trade_count();
+    Qty volume = book.total_volume();
+    auto best_bid = book.best_bid_price();
+    auto best_ask = book.best_ask_price();
+    ASSERT_TRUE(sim.save_checkpoint(path));
+
+    Simulator restored(config);
+    restored.run(100); // Different point in the run
+    ASSERT_TRUE(restored.restore_checkpoint(path));
+
+    const auto& restored_book = restored.get_matching_engine().get_order_book();
+    EXPECT_EQ(restored.get_matching_engine().order_count(), orders);
+    EXPECT_EQ(restored_book.trade_count(), trades);
+    EXPECT_EQ(restored_book.total_volume(), volume);
+    EXPECT_EQ(restored_book.best_bid_price(), best_bid);
+    EXPECT_EQ(restored_book.best_ask_price(), best_ask);
+
+    std::remove(path.c_str());
+}
+
+TEST_F(SimulatorTest, RestoreRejectsCorruptCheckpoint) {
+    std::string path = (std::filesystem::temp_directory_path() / "mms_test_checkpoint3.bin").string();
+    std::ofstream out(path, std::ios::binary);
+    out << "definitely not a checkpoint";
+    out.close();
+
+    Simulator sim(config);
+    sim.run(10);
+    EXPECT_FALSE(sim.restore_checkpoint(path));
+    EXPECT_FALSE(sim.restore_checkpoint(path + ".missing"));
+
+    std::remove(path.c_str());
+}
+
+TEST_F(SimulatorTest, AggregateOnlyMatchesFullRunStatistics) {
+    auto full_result = simulator->run(2000);
+    auto full_stats = simulator->get_stats();
+    ASSERT_GT(full_result.trades.size(), 0u);
+
+    SimulationConfig agg_config = config;
+    agg_config.aggregate_only = true;
+    agg_config.reservoir_rows = 256;
+    Simulator aggregated(agg_config);
+    auto agg_result = aggregated.run(2000);
+    auto agg_stats = aggregated.get_stats();
+
+    // The online accumulators must reproduce the second-pass statistics
+    // of an identical full-storage run
+    EXPECT_EQ(agg_result.aggregates.trade_count, full_result.trades.size());
+    EXPECT_EQ(agg_result.aggregates.snapshot_count, full_result.market_snapshots.size());
+    EXPECT_EQ(agg_result.aggregates.total_volume, full_stats.total_volume);
+    EXPECT_NEAR(agg_result.aggregates.vwap(), analysis::calculate_vwap(full_result.trades), 1e-9);
+    EXPECT_NEAR(agg_stats.average_spread, full_stats.average_spread, 1e-9);
+    EXPECT_NEAR(agg_stats.price_volatility, full_stats.price_volatility, 1e-9);
+}
+
+TEST_F(SimulatorTest, AggregateOnlyBoundsStoredRows) {
+    config.aggregate_only = true;
+    config.reservoir_rows = 4;
+    Simulator aggregated(config);
+    auto result = aggregated.run(2000);
+
+    // Raw vectors hold reservoir samples, never more than the cap
+    EXPECT_LE(result.trades.size(), 4u);
+    EXPECT_LE(result.market_snapshots.size(), 4u);
+    EXPECT_GT(result.aggregates.trade_count, result.trades.size());
+    EXPECT_GT(result.aggregates.snapshot_count, result.market_snapshots.size());
+
+    // PnL keeps one (latest) row per agent, not one per collection
+    EXPECT_EQ(result.agent_pnl.size(), 3u);
+}
+
+TEST_F(SimulatorTest, SpreadQuantilesComeFromHistogram) {
+    StreamingAggregates aggregates;
+    // 90 one-tick spreads, 10 five-tick spreads
+    for (int i = 0; i < 90; ++i) {
+        aggregates.add_snapshot(MarketSnapshot(100, 101, 10, 10, 100, 0));
+    }
+    for (int i = 0; i < 10; ++i) {
+        aggregates.add_snapshot(MarketSnapshot(100, 105, 10, 10, 100, 0));
+    }
+
+    EXPECT_EQ(aggregates.spread_count, 100u);
+    EXPECT_EQ(aggregates.spread_min, 1);
+    EXPECT_EQ(aggregates.spread_max, 5);
+    EXPECT_EQ(aggregates.spread_quantile(0.5), 1);
+    EXPECT_EQ(aggregates.spread_quantile(0.95), 5);
+    EXPECT_NEAR(aggregates.average_spread(), 1.4, 1e-12);
+}
+
+TEST_F(SimulatorTest, RunReportsMemoryPlacementStats) {
+    config.memory.huge_pages = HugePageMode::TRANSPARENT;
+    Simulator simulator(config);
+    auto result = simulator.run(500);
+
+    EXPECT_GT(result.memory_stats.arena_bytes_reserved, 0u);
+    EXPECT_EQ(result.memory_stats.arena_huge_bytes, result.memory_stats.arena_bytes_reserved);
+    EXPECT_GE(result.memory_stats.cpu, 0);
+}
+
 } // namespace mms
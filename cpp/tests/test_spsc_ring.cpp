@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "mms/spsc_ring.hpp"
+#include <thread>
+#include <vector>
+
+namespace mms {
+
+TEST(SPSCRingTest, PushPopPreservesFifoOrder) {
+    SPSCRing<int> ring(8);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(SPSCRingTest, CapacityRoundsUpToPowerOfTwo) {
+    SPSCRing<int> ring(5);
+    EXPECT_EQ(ring.capacity(), 8u);
+
+    SPSCRing<int> exact(16);
+    EXPECT_EQ(exact.capacity(), 16u);
+}
+
+TEST(SPSCRingTest, PushFailsWhenFull) {
+    SPSCRing<int> ring(4);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(99));
+
+    int value = -1;
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_TRUE(ring.try_push(99));
+}
+
+TEST(SPSCRingTest, WrapsAroundRepeatedly) {
+    SPSCRing<int> ring(4);
+
+    int value = -1;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SPSCRingTest, TwoThreadTransferPreservesAllValues) {
+    const int n_values = 100000;
+    SPSCRing<int> ring(1024);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < n_values; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<int> received;
+    received.reserve(n_values);
+    int value = -1;
+    while (received.size() < static_cast<size_t>(n_values)) {
+        if (ring.try_pop(value)) {
+            received.push_back(value);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    // FIFO order must survive the thread handoff
+    for (int i = 0; i < n_values; ++i) {
+        ASSERT_EQ(received[static_cast<size_t>(i)], i);
+    }
+}
+
+} // namespace mms
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "mms/sweep.hpp"
+
+namespace mms {
+
+class SweepRunnerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.base.seed = 42;
+        config.base.time_step = 1000;
+        config.base.output_dir = "";
+        config.first_seed = 100;
+        config.n_seeds = 4;
+        config.n_threads = 2;
+    }
+
+    SweepConfig config;
+};
+
+TEST_F(SweepRunnerTest, RunsEverySeedOnce) {
+    SweepRunner runner(config);
+    auto result = runner.run(200);
+
+    ASSERT_EQ(result.runs.size(), 4u);
+    for (size_t i = 0; i < result.runs.size(); ++i) {
+        EXPECT_EQ(result.runs[i].seed, 100u + i);
+        EXPECT_EQ(result.runs[i].config_index, 0u);
+        EXPECT_GT(result.runs[i].total_events_processed, 0u);
+    }
+    EXPECT_GT(result.total_trades, 0u);
+    EXPECT_GT(result.mean_events_per_run, 0.0);
+}
+
+TEST_F(SweepRunnerTest, ResultsIndependentOfWorkerCount) {
+    config.n_threads = 1;
+    SweepRunner serial(config);
+    auto serial_result = serial.run(200);
+
+    config.n_threads = 4;
+    SweepRunner parallel(config);
+    auto parallel_result = parallel.run(200);
+
+    ASSERT_EQ(serial_result.runs.size(), parallel_result.runs.size());
+    for (size_t i = 0; i < serial_result.runs.size(); ++i) {
+        EXPECT_EQ(serial_result.runs[i].seed, parallel_result.runs[i].seed);
+        EXPECT_EQ(serial_result.runs[i].total_trades, parallel_result.runs[i].total_trades);
+        EXPECT_EQ(serial_result.runs[i].total_events_processed,
+                  parallel_result.runs[i].total_events_processed);
+        EXPECT_DOUBLE_EQ(serial_result.runs[i].vwap, parallel_result.runs[i].vwap);
+    }
+}
+
+TEST_F(SweepRunnerTest, GridExpandsAcrossSeeds) {
+    AgentConfigPoint tight;
+    tight.maker_config.spread = 2;
+    AgentConfigPoint wide;
+    wide.maker_config.spread = 10;
+    config.grid = {tight, wide};
+    config.n_seeds = 3;
+
+    SweepRunner runner(config);
+    EXPECT_EQ(runner.n_jobs(), 6u);
+
+    auto result = runner.run(100);
+    ASSERT_EQ(result.runs.size(), 6u);
+    for (size_t i = 0; i < result.runs.size(); ++i) {
+        EXPECT_EQ(result.runs[i].config_index, i / 3);
+        EXPECT_EQ(result.runs[i].seed, 100u + i % 3);
+    }
+}
+
+TEST_F(SweepRunnerTest, PinnedWorkersProduceIdenticalResults) {
+    config.n_threads = 2;
+    SweepRunner unpinned(config);
+    auto unpinned_result = unpinned.run(200);
+
+    config.base.memory.pin_workers = true;
+    config.base.memory.huge_pages = HugePageMode::TRANSPARENT;
+    SweepRunner pinned(config);
+    auto pinned_result = pinned.run(200);
+
+    ASSERT_EQ(unpinned_result.runs.size(), pinned_result.runs.size());
+    for (size_t i = 0; i < unpinned_result.runs.size(); ++i) {
+        EXPECT_EQ(unpinned_result.runs[i].seed, pinned_result.runs[i].seed);
+        EXPECT_EQ(unpinned_result.runs[i].total_trades, pinned_result.runs[i].total_trades);
+        EXPECT_EQ(unpinned_result.runs[i].total_events_processed,
+                  pinned_result.runs[i].total_events_processed);
+    }
+}
+
+TEST_F(SweepRunnerTest, WorkerCountCappedByJobCount) {
+    config.n_seeds = 2;
+    config.n_threads = 16;
+    SweepRunner runner(config);
+    EXPECT_EQ(runner.n_workers(), 2u);
+}
+
+} // namespace mms
@@ -9,6 +9,7 @@ from .core import MarketMakerConfig, TakerConfig, NoiseTraderConfig
 from .core import Side, EventType, Order, Trade, MarketSnapshot
 from .strategies import SimpleStrategy, MeanReversionStrategy, MomentumStrategy
 from .utils import create_sample_agents, plot_results, save_results
+from .utils import read_columnar, load_binary_results
 
 __version__ = "1.0.0"
 __author__ = "Market Microstructure Team"
@@ -29,5 +30,7 @@ __all__ = [
     "MomentumStrategy",
     "create_sample_agents",
     "plot_results",
-    "save_results"
+    "save_results",
+    "read_columnar",
+    "load_binary_results"
 ]
@@ -11,6 +11,117 @@ import os
 from .core import create_dataframes, calculate_statistics
 
 
+# Column layouts for the binary columnar files written by
+# MarketDataCollector::save_to_binary / streaming mode (see simulator.cpp).
+# Every column is a fixed-width 64-bit little-endian value.
+TRADE_COLUMNS = [
+    ("timestamp", "<i8"),
+    ("maker_id", "<u8"),
+    ("taker_id", "<u8"),
+    ("price", "<i8"),
+    ("quantity", "<i8"),
+]
+
+SNAPSHOT_COLUMNS = [
+    ("timestamp", "<i8"),
+    ("best_bid", "<i8"),
+    ("best_ask", "<i8"),
+    ("best_bid_qty", "<i8"),
+    ("best_ask_qty", "<i8"),
+    ("last_trade_price", "<i8"),
+]
+
+AGENT_PNL_COLUMNS = [
+    ("timestamp", "<i8"),
+    ("agent_id", "<u8"),
+    ("pnl", "<f8"),
+    ("inventory", "<i8"),
+]
+
+_COLUMNAR_MAGIC = b"MMSC"
+_COLUMNAR_VERSION = 1
+
+
+def read_columnar(path: str,
+                  columns: List[Tuple[str, str]]) -> Dict[str, np.ndarray]:
+    """
+    Read a binary columnar file into NumPy arrays.
+
+    File layout: a 16-byte header (magic "MMSC", u32 version, u32 n_columns,
+    u32 reserved) followed by blocks of `u64 n_rows` plus one contiguous
+    64-bit column per field. Single-block files (the one-shot save path)
+    are returned as zero-copy views over a memory map; multi-block files
+    (streaming mode) are concatenated.
+
+    Args:
+        path: Path to a .bin file written by the C++ collector
+        columns: List of (name, dtype) pairs, e.g. TRADE_COLUMNS
+
+    Returns:
+        Dictionary mapping column name to NumPy array
+    """
+    data = np.memmap(path, dtype=np.uint8, mode="r")
+
+    if data.size < 16 or data[:4].tobytes() != _COLUMNAR_MAGIC:
+        raise ValueError(f"{path} is not a columnar file (bad magic)")
+    version, n_columns, _ = np.frombuffer(data, dtype="<u4", count=3, offset=4)
+    if version != _COLUMNAR_VERSION:
+        raise ValueError(f"{path}: unsupported columnar version {version}")
+    if n_columns != len(columns):
+        raise ValueError(f"{path}: expected {len(columns)} columns, file has {n_columns}")
+
+    blocks: Dict[str, List[np.ndarray]] = {name: [] for name, _ in columns}
+    offset = 16
+    while offset < data.size:
+        n_rows = int(np.frombuffer(data, dtype="<u8", count=1, offset=offset)[0])
+        offset += 8
+        for name, dtype in columns:
+            blocks[name].append(np.frombuffer(data, dtype=dtype, count=n_rows, offset=offset))
+            offset += n_rows * 8
+
+    result = {}
+    for name, dtype in columns:
+        parts = blocks[name]
+        if not parts:
+            result[name] = np.empty(0, dtype=dtype)
+        elif len(parts) == 1:
+            result[name] = parts[0]
+        else:
+            result[name] = np.concatenate(parts)
+    return result
+
+
+def load_binary_results(output_dir: str) -> Dict[str, pd.DataFrame]:
+    """
+    Load a binary-output run directory into DataFrames.
+
+    Reads trades.bin, market_snapshots.bin and agent_pnl.bin written by a
+    run with binary_output enabled (or streaming mode) and returns the
+    same dictionary shape as create_dataframes() for CSV runs.
+
+    Args:
+        output_dir: Directory containing the .bin files
+
+    Returns:
+        Dictionary with 'trades', 'market_snapshots' and 'agent_pnl'
+        DataFrames (missing files become empty DataFrames)
+    """
+    files = {
+        'trades': ('trades.bin', TRADE_COLUMNS),
+        'market_snapshots': ('market_snapshots.bin', SNAPSHOT_COLUMNS),
+        'agent_pnl': ('agent_pnl.bin', AGENT_PNL_COLUMNS),
+    }
+
+    dfs = {}
+    for key, (filename, columns) in files.items():
+        path = os.path.join(output_dir, filename)
+        if os.path.exists(path):
+            dfs[key] = pd.DataFrame(read_columnar(path, columns))
+        else:
+            dfs[key] = pd.DataFrame(columns=[name for name, _ in columns])
+    return dfs
+
+
 def plot_results(result_dict: Dict[str, np.ndarray], 
                 output_dir: str = "plots",
                 figsize: Tuple[int, int] = (15, 10)) -> None:
@@ -7,9 +7,20 @@
 #include <mms/matching_engine.hpp>
 #include <mms/agents.hpp>
 #include <mms/simulator.hpp>
+#include <mms/sweep.hpp>
 
 namespace py = pybind11;
 
+// Zero-copy NumPy view over one collector column. The array aliases the
+// C++ vector's storage directly (no element-wise conversion); `owner` is
+// installed as the array's base so the owning Python object stays alive
+// for as long as any view does. Views are invalidated by the next run()
+// or reset(), like any iterator into the collector.
+template <typename T>
+static py::array_t<T> column_view(const std::vector<T>& column, py::handle owner) {
+    return py::array_t<T>({column.size()}, {sizeof(T)}, column.data(), owner);
+}
+
 PYBIND11_MODULE(mms_core, m) {
     m.doc() = "Market Microstructure Simulator - C++ Core";
     
@@ -74,7 +85,7 @@ PYBIND11_MODULE(mms_core, m) {
     // OrderBook
     py::class_<mms::OrderBook>(m, "OrderBook")
         .def(py::init<>())
-        .def("add_limit_order", &mms::OrderBook::add_limit_order)
+        .def("add_limit_order", py::overload_cast<const mms::Order&>(&mms::OrderBook::add_limit_order))
         .def("add_market_order", &mms::OrderBook::add_market_order)
         .def("cancel_order", &mms::OrderBook::cancel_order)
         .def("best_bid_price", &mms::OrderBook::best_bid_price)
@@ -106,8 +117,8 @@ PYBIND11_MODULE(mms_core, m) {
     // MatchingEngine
     py::class_<mms::MatchingEngine>(m, "MatchingEngine")
         .def(py::init<>())
-        .def("process_event", &mms::MatchingEngine::process_event)
-        .def("process_events", &mms::MatchingEngine::process_events)
+        .def("process_event", py::overload_cast<const mms::Event&>(&mms::MatchingEngine::process_event))
+        .def("process_events", py::overload_cast<const std::vector<mms::Event>&>(&mms::MatchingEngine::process_events))
         .def("get_market_snapshot", &mms::MatchingEngine::get_market_snapshot)
         .def("get_depth", &mms::MatchingEngine::get_depth, py::arg("levels") = 10)
         .def("order_count", &mms::MatchingEngine::order_count)
@@ -150,7 +161,13 @@ PYBIND11_MODULE(mms_core, m) {
         .def_readwrite("time_step", &mms::SimulationConfig::time_step)
         .def_readwrite("max_steps", &mms::SimulationConfig::max_steps)
         .def_readwrite("enable_logging", &mms::SimulationConfig::enable_logging)
-        .def_readwrite("output_dir", &mms::SimulationConfig::output_dir);
+        .def_readwrite("output_dir", &mms::SimulationConfig::output_dir)
+        .def_readwrite("binary_output", &mms::SimulationConfig::binary_output)
+        .def_readwrite("event_driven", &mms::SimulationConfig::event_driven)
+        .def_readwrite("pipelined", &mms::SimulationConfig::pipelined)
+        .def_readwrite("self_trade_prevention", &mms::SimulationConfig::self_trade_prevention)
+        .def_readwrite("aggregate_only", &mms::SimulationConfig::aggregate_only)
+        .def_readwrite("reservoir_rows", &mms::SimulationConfig::reservoir_rows);
     
     // RunResult
     py::class_<mms::Simulator::RunResult>(m, "RunResult")
@@ -166,9 +183,43 @@ PYBIND11_MODULE(mms_core, m) {
     py::class_<mms::Simulator>(m, "Simulator")
         .def(py::init<>())
         .def(py::init<const mms::SimulationConfig&>())
-        .def("run", py::overload_cast<size_t, const mms::MarketMaker::Config&, const mms::Taker::Config&, const mms::NoiseTrader::Config&>(&mms::Simulator::run))
+        .def("run", py::overload_cast<size_t, const mms::MarketMaker::Config&, const mms::Taker::Config&, const mms::NoiseTrader::Config&>(&mms::Simulator::run),
+             py::call_guard<py::gil_scoped_release>())
+        .def("resume", &mms::Simulator::resume, py::call_guard<py::gil_scoped_release>())
         .def("run_with_agents", &mms::Simulator::run_with_agents)
         .def("reset", &mms::Simulator::reset)
+        // O(1) result transfer: NumPy arrays aliasing the collector's
+        // columnar buffers, keyed by column name
+        .def("trade_arrays", [](py::object self) {
+            const auto& columns = self.cast<mms::Simulator&>().get_data_collector().trade_columns();
+            py::dict arrays;
+            arrays["timestamp"] = column_view(columns.timestamp, self);
+            arrays["maker_id"] = column_view(columns.maker_id, self);
+            arrays["taker_id"] = column_view(columns.taker_id, self);
+            arrays["price"] = column_view(columns.price, self);
+            arrays["quantity"] = column_view(columns.quantity, self);
+            return arrays;
+        })
+        .def("snapshot_arrays", [](py::object self) {
+            const auto& columns = self.cast<mms::Simulator&>().get_data_collector().snapshot_columns();
+            py::dict arrays;
+            arrays["timestamp"] = column_view(columns.timestamp, self);
+            arrays["best_bid"] = column_view(columns.best_bid, self);
+            arrays["best_ask"] = column_view(columns.best_ask, self);
+            arrays["best_bid_qty"] = column_view(columns.best_bid_qty, self);
+            arrays["best_ask_qty"] = column_view(columns.best_ask_qty, self);
+            arrays["last_trade_price"] = column_view(columns.last_trade_price, self);
+            return arrays;
+        })
+        .def("agent_pnl_arrays", [](py::object self) {
+            const auto& columns = self.cast<mms::Simulator&>().get_data_collector().agent_pnl_columns();
+            py::dict arrays;
+            arrays["agent_id"] = column_view(columns.agent_id, self);
+            arrays["timestamp"] = column_view(columns.timestamp, self);
+            arrays["pnl"] = column_view(columns.pnl, self);
+            arrays["inventory"] = column_view(columns.inventory, self);
+            return arrays;
+        })
         .def("update_config", &mms::Simulator::update_config)
         .def("set_data_collection", &mms::Simulator::set_data_collection)
         .def("set_output_dir", &mms::Simulator::set_output_dir);
@@ -188,6 +239,45 @@ PYBIND11_MODULE(mms_core, m) {
         .def("bernoulli", &mms::RNG::bernoulli)
         .def("seed", &mms::RNG::seed);
     
+    // Sweep driver
+    py::class_<mms::AgentConfigPoint>(m, "AgentConfigPoint")
+        .def(py::init<>())
+        .def_readwrite("maker_config", &mms::AgentConfigPoint::maker_config)
+        .def_readwrite("taker_config", &mms::AgentConfigPoint::taker_config)
+        .def_readwrite("noise_config", &mms::AgentConfigPoint::noise_config);
+    
+    py::class_<mms::SweepConfig>(m, "SweepConfig")
+        .def(py::init<>())
+        .def_readwrite("base", &mms::SweepConfig::base)
+        .def_readwrite("first_seed", &mms::SweepConfig::first_seed)
+        .def_readwrite("n_seeds", &mms::SweepConfig::n_seeds)
+        .def_readwrite("n_threads", &mms::SweepConfig::n_threads)
+        .def_readwrite("grid", &mms::SweepConfig::grid);
+    
+    py::class_<mms::SweepRunner::RunSummary>(m, "SweepRunSummary")
+        .def_readonly("seed", &mms::SweepRunner::RunSummary::seed)
+        .def_readonly("config_index", &mms::SweepRunner::RunSummary::config_index)
+        .def_readonly("total_events_processed", &mms::SweepRunner::RunSummary::total_events_processed)
+        .def_readonly("total_trades", &mms::SweepRunner::RunSummary::total_trades)
+        .def_readonly("vwap", &mms::SweepRunner::RunSummary::vwap)
+        .def_readonly("simulation_time_seconds", &mms::SweepRunner::RunSummary::simulation_time_seconds);
+    
+    py::class_<mms::SweepRunner::SweepResult>(m, "SweepResult")
+        .def_readonly("runs", &mms::SweepRunner::SweepResult::runs)
+        .def_readonly("total_events_processed", &mms::SweepRunner::SweepResult::total_events_processed)
+        .def_readonly("total_trades", &mms::SweepRunner::SweepResult::total_trades)
+        .def_readonly("mean_trades_per_run", &mms::SweepRunner::SweepResult::mean_trades_per_run)
+        .def_readonly("std_trades_per_run", &mms::SweepRunner::SweepResult::std_trades_per_run)
+        .def_readonly("mean_events_per_run", &mms::SweepRunner::SweepResult::mean_events_per_run)
+        .def_readonly("std_events_per_run", &mms::SweepRunner::SweepResult::std_events_per_run)
+        .def_readonly("wall_time_seconds", &mms::SweepRunner::SweepResult::wall_time_seconds);
+    
+    py::class_<mms::SweepRunner>(m, "SweepRunner")
+        .def(py::init<const mms::SweepConfig&>())
+        .def("run", &mms::SweepRunner::run, py::call_guard<py::gil_scoped_release>())
+        .def("n_jobs", &mms::SweepRunner::n_jobs)
+        .def("n_workers", &mms::SweepRunner::n_workers);
+    
     // Utility functions
     m.def("side_to_string", &mms::side_to_string);
     m.def("event_type_to_string", &mms::event_type_to_string);
@@ -195,8 +285,13 @@ PYBIND11_MODULE(mms_core, m) {
     m.def("get_spread", &mms::get_spread);
     m.def("generate_time_seed", &mms::generate_time_seed);
     
-    // Analysis functions
-    m.def("calculate_vwap", &mms::analysis::calculate_vwap);
-    m.def("calculate_twap", &mms::analysis::calculate_twap);
-    m.def("calculate_realized_volatility", &mms::analysis::calculate_realized_volatility);
+    // Analysis functions (the row-wise overloads; the columnar ones are
+    // reached from Python through the *_arrays views plus NumPy)
+    m.def("calculate_vwap",
+          py::overload_cast<const std::vector<mms::Trade>&>(&mms::analysis::calculate_vwap));
+    m.def("calculate_twap",
+          py::overload_cast<const std::vector<mms::MarketSnapshot>&>(&mms::analysis::calculate_twap));
+    m.def("calculate_realized_volatility",
+          py::overload_cast<const std::vector<mms::MarketSnapshot>&>(
+              &mms::analysis::calculate_realized_volatility));
 }
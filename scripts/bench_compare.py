@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""
+Microbenchmark regression gate
+
+Compares two mms_bench JSON outputs (--benchmark_format=json) and fails
+if any benchmark slowed down by more than the allowed threshold.
+
+Usage:
+  mms_bench --benchmark_format=json > baseline.json   # on the old build
+  mms_bench --benchmark_format=json > candidate.json  # on the new build
+  python bench_compare.py baseline.json candidate.json --threshold 10
+"""
+
+import argparse
+import json
+import sys
+
+
+def parse_arguments():
+    """Parse command line arguments."""
+    parser = argparse.ArgumentParser(
+        description="Compare mms_bench JSON outputs and flag regressions"
+    )
+    parser.add_argument("baseline", help="Baseline benchmark JSON file")
+    parser.add_argument("candidate", help="Candidate benchmark JSON file")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=10.0,
+        help="Allowed slowdown in percent before failing (default: 10)",
+    )
+    return parser.parse_args()
+
+
+def load_benchmarks(path):
+    """Load a benchmark JSON file into {name: real_time_ns}."""
+    with open(path) as f:
+        data = json.load(f)
+
+    results = {}
+    for bench in data.get("benchmarks", []):
+        # Skip aggregate rows (mean/median/stddev) from repeated runs
+        if bench.get("run_type") == "aggregate":
+            continue
+        results[bench["name"]] = float(bench["real_time"])
+    return results
+
+
+def main():
+    args = parse_arguments()
+
+    baseline = load_benchmarks(args.baseline)
+    candidate = load_benchmarks(args.candidate)
+
+    common = sorted(set(baseline) & set(candidate))
+    if not common:
+        print("error: no common benchmarks between the two files", file=sys.stderr)
+        return 2
+
+    regressions = []
+    name_width = max(len(name) for name in common)
+    print(f"{'benchmark':<{name_width}}  {'baseline':>12}  {'candidate':>12}  {'delta':>8}")
+    for name in common:
+        old = baseline[name]
+        new = candidate[name]
+        delta_pct = (new - old) / old * 100.0 if old > 0 else 0.0
+        marker = ""
+        if delta_pct > args.threshold:
+            regressions.append((name, delta_pct))
+            marker = "  <-- REGRESSION"
+        print(
+            f"{name:<{name_width}}  {old:>10.1f}ns  {new:>10.1f}ns  "
+            f"{delta_pct:>+7.1f}%{marker}"
+        )
+
+    only_baseline = sorted(set(baseline) - set(candidate))
+    if only_baseline:
+        print(f"\nwarning: missing from candidate: {', '.join(only_baseline)}")
+
+    if regressions:
+        print(
+            f"\nFAIL: {len(regressions)} benchmark(s) regressed beyond "
+            f"{args.threshold:.1f}%",
+            file=sys.stderr,
+        )
+        return 1
+
+    print(f"\nOK: no regressions beyond {args.threshold:.1f}%")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())